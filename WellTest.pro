@@ -27,6 +27,15 @@ QMAKE_CXXFLAGS_RELEASE += -O3
 # [关键配置] 设置生成的 .exe 文件图标
 win32: RC_ICONS = Resource/PWT.ico
 
+# [SIMD] Bessel 函数批量计算的 AVX2/AVX-512 实现通过 target 预处理指令单独编译，运行时按 CPU 分派。
+# MinGW 不保证 32/64 字节栈对齐，令汇编器把对齐向量访存改为非对齐访存，避免 AVX 代码栈溢出访问崩溃。
+win32-g++: QMAKE_CXXFLAGS += -Wa,-muse-unaligned-vector-move
+
+# [计算核心] 求解器、压力导数算法与拟合器编译在 welltest_core 静态库中 (core/welltest_core.pro)，
+# 本工程只链接该库；请通过总工程 WellTestProject.pro 构建，以保证核心库先于界面程序生成。
+# 核心库的头文件不在本工程的 HEADERS 中重复列出，避免带 Q_OBJECT 的类被 moc 处理两次。
+include(welltest_core.pri)
+
 # 数学库链接
 unix: LIBS += -lm
 win32: LIBS += -lm
@@ -64,7 +73,6 @@ HEADERS += \
            modelmanager.h \
            modelparameter.h \
            modelselect.h \
-           modelsolver01-06.h \
            mousezoom.h \
            newprojectdialog.h \
            paramselectdialog.h \
@@ -76,8 +84,6 @@ HEADERS += \
            plottingdialog2.h \
            plottingdialog3.h \
            plottingdialog4.h \
-           pressurederivativecalculator.h \
-           pressurederivativecalculator1.h \
            settingswidget.h \
            qcustomplot.h \
            styleselectordialog.h \
@@ -132,7 +138,6 @@ SOURCES += \
            modelmanager.cpp \
            modelparameter.cpp \
            modelselect.cpp \
-           modelsolver01-06.cpp \
            mousezoom.cpp \
            newprojectdialog.cpp \
            paramselectdialog.cpp \
@@ -145,8 +150,8 @@ SOURCES += \
            plottingdialog2.cpp \
            plottingdialog3.cpp \
            plottingdialog4.cpp \
-           pressurederivativecalculator.cpp \
-           pressurederivativecalculator1.cpp \
+           pressurederivativecalculator1_model.cpp \
+           pressurederivativecalculator_model.cpp \
            settingswidget.cpp \
            qcustomplot.cpp \
            styleselectordialog.cpp \
@@ -0,0 +1,22 @@
+# ----------------------------------------------------
+# Project: WellTestProject
+# Description: 试井分析软件总工程 (先构建计算核心库，再构建界面程序与命令行工具)
+# ----------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += core app benchmark accuracy
+
+# 计算核心静态库 (只依赖 QtCore、Eigen)
+core.file = core/welltest_core.pro
+
+# 界面程序
+app.file = WellTest.pro
+app.depends = core
+
+# 性能基准与精度回归检查 (命令行程序)
+benchmark.file = benchmark/SolverBenchmark.pro
+benchmark.depends = core
+
+accuracy.file = accuracy/SolverAccuracy.pro
+accuracy.depends = core
@@ -0,0 +1,531 @@
+/*
+ * solveraccuracy.cpp
+ * 文件作用: 模型求解器精度回归检查 (命令行程序)
+ * 功能描述:
+ * 1. 生成模式 (--generate): 对六个模型各三组固定参数计算高精度参考曲线并写入 golden 文件。
+ *    参考解使用 Talbot 反演 (M = 32)、裂缝积分相对误差限 1e-13、关闭渐近快速路径，
+ *    并以 de Hoog 反演 (M = 24) 独立计算一遍，两者的最大偏差作为参考解自身的误差估计写入文件头。
+ * 2. 检查模式 (默认): 读取 golden 文件，对全部快速路径 (各反演方法与阶数、快速模式、渐近快速路径、
+ *    典型曲线缓存、自适应网格插值、自动微分曲线、各 SIMD 指令集) 计算压差与导数的最大相对误差，
+ *    超出该路径的误差上限时返回非零退出码。典型曲线缓存与自动微分曲线改以同一配置下不经缓存的
+ *    直接计算为参照，只检查其自身引入的误差。
+ * 3. 同时给出每条路径的耗时，并标出精度-耗时 Pareto 最优的路径，便于调整速度参数。
+ * 4. 相对误差以参考值为分母；低于曲线最大值 1e-3 倍的点 (如定压边界晚期导数) 以该下限为分母。
+ * 5. 导数另做符号检查: 任何路径在任何时间点给出非正导数 (参考导数恒为正) 都判为失败。
+ *    Stehfest 路径 (含缓存路径) 的导数误差只在排除窗口 (kDerivativeWindows) 以外统计，窗口内只检查符号。
+ */
+
+#include "modelsolver01-06.h"
+#include "besselfunctions.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#ifndef SOLVER_ACCURACY_GOLDEN_DIR
+#define SOLVER_ACCURACY_GOLDEN_DIR "golden"
+#endif
+
+namespace {
+
+// 参考解设置
+const LaplaceInversion::Method kReferenceMethod = LaplaceInversion::Talbot;
+const int kReferenceOrder = 32;
+const LaplaceInversion::Method kCrossCheckMethod = LaplaceInversion::DeHoog;
+const int kCrossCheckOrder = 24;
+const double kReferenceQuadratureTolerance = 1e-13;
+// 参考时间: 1e-3 ~ 1e5 h，每十倍程 5 点 (覆盖到封闭/定压边界的晚期响应)
+const int kReferencePoints = 41;
+// 相对误差分母的下限 (相对于曲线最大值)
+const double kRelativeFloor = 1e-3;
+
+// Stehfest 路径导数误差的排除窗口 (model/set 为 0 时匹配全部，时间单位 h，端点包含在内)。
+// 这些区间上参考导数降到峰值的百分之几或只能单侧差分，Stehfest 的相对误差被放大到 O(1)，
+// 误差上限若覆盖它们就失去了检查意义；窗口内仍检查导数符号
+const double kNoUpperTime = std::numeric_limits<double>::infinity();
+struct DerivativeWindow {
+    int model;
+    int set;
+    double tMin;
+    double tMax;
+    const char* reason;
+};
+const DerivativeWindow kDerivativeWindows[] = {
+    { 0, 0, 0.0, 1.5e-3, "曲线起点: 低阶 Stehfest 的 Bourdet 导数只能单侧差分" },
+    { 0, 0, 9e4, kNoUpperTime, "曲线终点: 同上" },
+    { 0, 1, 25.0, 160.0, "参数组 1 双重孔隙窜流凹槽 (lambda1 = 1e-3)" },
+    { 0, 3, 10.0, 160.0, "参数组 3 双重孔隙窜流凹槽 (lambda1 = 1e-4)" },
+    { 5, 0, 1.5e4, kNoUpperTime, "定压边界晚期: 导数向零衰减" },
+    { 6, 0, 1.5e4, kNoUpperTime, "定压边界晚期: 导数向零衰减" },
+};
+
+bool inDerivativeWindow(int model, int set, double t)
+{
+    for (const DerivativeWindow& w : kDerivativeWindows) {
+        if ((w.model == 0 || w.model == model) && (w.set == 0 || w.set == set) && t >= w.tMin && t <= w.tMax) return true;
+    }
+    return false;
+}
+
+// 一组参考曲线: 模型、参数与参考值
+struct GoldenCurve {
+    int model = 1;
+    int set = 1;
+    QMap<QString, double> params;
+    QVector<double> t, p, d;
+    double referenceError = 0.0;
+
+    QString fileName() const { return QString("model%1_set%2.txt").arg(model).arg(set); }
+};
+
+// 固定参数组: 1 为默认参数 (与 ModelManager::getDefaultParameters 一致)，
+// 2 为单条裂缝、强窜流的小复合区，3 为 9 条裂缝、弱窜流的大复合区与较大表皮
+QMap<QString, double> referenceParams(int model, int set)
+{
+    const bool storage = (model % 2 == 1);
+    const bool bounded = (model >= 3);
+    QMap<QString, double> p;
+    p.insert("phi", 0.05);
+    p.insert("h", 20.0);
+    p.insert("mu", 0.5);
+    p.insert("B", 1.05);
+    p.insert("Ct", 5e-4);
+    p.insert("q", 5.0);
+    p.insert("kf", 1e-3);
+    p.insert("L", 1000.0);
+    p.insert("N", 8.0);
+    switch (set) {
+    case 1:
+        p.insert("nf", 4.0);   p.insert("km", 1e-4);     p.insert("Lf", 100.0);
+        p.insert("rmD", 4.0);  p.insert("omega1", 0.4);  p.insert("omega2", 0.08);
+        p.insert("lambda1", 1e-3); p.insert("gamaD", 0.02);
+        p.insert("cD", storage ? 0.01 : 0.0);  p.insert("S", storage ? 1.0 : 0.0);
+        if (bounded) p.insert("reD", 10.0);
+        break;
+    case 2:
+        p.insert("nf", 1.0);   p.insert("km", 2e-4);     p.insert("Lf", 50.0);
+        p.insert("rmD", 2.0);  p.insert("omega1", 0.2);  p.insert("omega2", 0.05);
+        p.insert("lambda1", 1e-2); p.insert("gamaD", 0.0);
+        p.insert("cD", storage ? 0.1 : 0.0);   p.insert("S", storage ? 0.5 : 0.0);
+        if (bounded) p.insert("reD", 6.0);
+        break;
+    default:
+        p.insert("nf", 9.0);   p.insert("km", 5e-5);     p.insert("Lf", 80.0);
+        p.insert("rmD", 8.0);  p.insert("omega1", 0.6);  p.insert("omega2", 0.15);
+        p.insert("lambda1", 1e-4); p.insert("gamaD", 0.05);
+        p.insert("cD", storage ? 0.001 : 0.0); p.insert("S", storage ? 3.0 : 0.0);
+        if (bounded) p.insert("reD", 20.0);
+        break;
+    }
+    if (p.value("L") > 1e-9) p.insert("LfD", p.value("Lf") / p.value("L"));
+    return p;
+}
+
+SolverConfig referenceConfig(LaplaceInversion::Method method, int order)
+{
+    SolverConfig config;
+    config.inversionMethod = method;
+    config.inversionOrder = order;
+    config.quadratureTolerance = kReferenceQuadratureTolerance;
+    config.asymptoticTolerance = 0.0;
+    return config;
+}
+
+// 两条曲线的最大相对误差 (分母下限为参考曲线最大绝对值的 kRelativeFloor 倍)
+double maxRelativeError(const QVector<double>& value, const QVector<double>& reference)
+{
+    double scale = 0.0;
+    for (double r : reference) scale = std::max(scale, std::abs(r));
+    const double floor = std::max(scale * kRelativeFloor, 1e-300);
+    double worst = 0.0;
+    const int n = std::min(value.size(), reference.size());
+    for (int i = 0; i < n; ++i) {
+        const double err = std::abs(value[i] - reference[i]) / std::max(std::abs(reference[i]), floor);
+        worst = std::max(worst, std::isfinite(err) ? err : 1e300);
+    }
+    if (value.size() != reference.size()) worst = 1e300;
+    return worst;
+}
+
+// 同上，只统计 include 为 true 的点 (分母下限仍取整条参考曲线)
+double maxRelativeError(const QVector<double>& value, const QVector<double>& reference, const QVector<bool>& include)
+{
+    QVector<double> v = value, r = reference;
+    const int n = std::min({ value.size(), reference.size(), include.size() });
+    for (int i = 0; i < n; ++i) {
+        if (!include[i]) v[i] = r[i];
+    }
+    return maxRelativeError(v, r);
+}
+
+// 符号错误的点数: 参考值为正而计算值非正 (或非有限)
+int countSignErrors(const QVector<double>& value, const QVector<double>& reference)
+{
+    int count = std::abs(int(value.size()) - int(reference.size()));
+    const int n = std::min(value.size(), reference.size());
+    for (int i = 0; i < n; ++i) {
+        if (reference[i] > 0.0 && !(value[i] > 0.0 && std::isfinite(value[i]))) ++count;
+    }
+    return count;
+}
+
+// ========================================================================
+// golden 文件读写
+// ========================================================================
+bool writeGolden(const QString& dir, const GoldenCurve& curve)
+{
+    QFile file(QDir(dir).filePath(curve.fileName()));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) return false;
+    QTextStream out(&file);
+    out << "# SolverAccuracy reference curve\n";
+    out << "# model " << curve.model << " set " << curve.set << "\n";
+    out << "# reference " << LaplaceInversion::methodName(kReferenceMethod) << " M=" << kReferenceOrder
+        << ", quadrature tolerance " << kReferenceQuadratureTolerance << ", asymptotic paths off\n";
+    out << "# referenceError " << QString::number(curve.referenceError, 'g', 6)
+        << " (max relative deviation from " << LaplaceInversion::methodName(kCrossCheckMethod)
+        << " M=" << kCrossCheckOrder << ")\n";
+    for (auto it = curve.params.constBegin(); it != curve.params.constEnd(); ++it) {
+        out << "# param " << it.key() << " " << QString::number(it.value(), 'g', 17) << "\n";
+    }
+    out << "# t(h) dp(MPa) dp'(MPa)\n";
+    for (int i = 0; i < curve.t.size(); ++i) {
+        out << QString::number(curve.t[i], 'g', 17) << " " << QString::number(curve.p[i], 'g', 17)
+            << " " << QString::number(curve.d[i], 'g', 17) << "\n";
+    }
+    return true;
+}
+
+bool readGolden(const QString& path, GoldenCurve& curve)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return false;
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty()) continue;
+        const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+        if (line.startsWith("#")) {
+            if (parts.size() >= 5 && parts[1] == "model") {
+                curve.model = parts[2].toInt();
+                curve.set = parts[4].toInt();
+            } else if (parts.size() >= 4 && parts[1] == "param") {
+                curve.params.insert(parts[2], parts[3].toDouble());
+            } else if (parts.size() >= 3 && parts[1] == "referenceError") {
+                curve.referenceError = parts[2].toDouble();
+            }
+            continue;
+        }
+        if (parts.size() < 3) continue;
+        curve.t.append(parts[0].toDouble());
+        curve.p.append(parts[1].toDouble());
+        curve.d.append(parts[2].toDouble());
+    }
+    return !curve.t.isEmpty() && curve.model >= 1 && curve.model <= 6;
+}
+
+// ========================================================================
+// 待检查的快速路径
+// ========================================================================
+struct FastPath {
+    enum Kind { Direct, Cache, Adaptive, Sensitivity };
+
+    QString name;
+    SolverConfig config;
+    Kind kind = Direct;
+    int simd = -1;          // 指定 SIMD 指令集 (-1 为自动检测)
+    double boundP = 1.0;    // 压差最大相对误差的上限
+    double boundD = 1.0;    // 导数最大相对误差的上限
+    bool derivativeWindows = false;     // 导数误差是否排除 kDerivativeWindows 中的区间
+
+    // 缓存插值与自动微分曲线以同一配置下不经缓存的直接计算为参照，
+    // 只检查其自身引入的误差 (不含反演方法本身的误差)；其余路径以参考曲线为参照
+    bool comparesToDirect() const { return kind == Cache || kind == Sensitivity; }
+};
+
+FastPath makePath(const QString& name, LaplaceInversion::Method method, int order, bool highPrecision,
+                  double boundP, double boundD)
+{
+    FastPath path;
+    path.name = name;
+    path.config.inversionMethod = method;
+    path.config.inversionOrder = order;
+    path.config.highPrecision = highPrecision;
+    path.boundP = boundP;
+    path.boundD = boundD;
+    return path;
+}
+
+// 误差上限约为当前实现实测误差的 3 倍，新的优化使误差明显变大时检查失败；
+// 以参考曲线为参照的上限不低于参考解自身误差 (检查时再与 golden 文件中的 referenceError 取大)。
+// Stehfest 的导数上限只针对排除窗口以外的点，窗口内的误差不设上限、只要求符号正确
+FastPath makeStehfestPath(int order, double boundP, double boundD)
+{
+    FastPath path = makePath(QString("Stehfest N=%1").arg(order), LaplaceInversion::Stehfest, order, true, boundP, boundD);
+    path.derivativeWindows = true;
+    return path;
+}
+
+QVector<FastPath> fastPaths()
+{
+    QVector<FastPath> paths;
+    paths.append(makeStehfestPath(4, 0.25, 0.5));
+    paths.append(makeStehfestPath(8, 6e-3, 0.18));
+    paths.append(makeStehfestPath(12, 6e-4, 0.04));
+    paths.append(makeStehfestPath(16, 6e-5, 6e-3));
+    paths.append(makePath("Talbot (fast)", LaplaceInversion::Talbot, 0, false, 1e-6, 1.5e-4));
+    paths.append(makePath("Talbot", LaplaceInversion::Talbot, 0, true, 1e-6, 2e-6));
+    paths.append(makePath("de Hoog (fast)", LaplaceInversion::DeHoog, 0, false, 1e-5, 1.5e-3));
+    paths.append(makePath("de Hoog", LaplaceInversion::DeHoog, 0, true, 1e-6, 5e-5));
+    paths.append(makePath("Euler (fast)", LaplaceInversion::Euler, 0, false, 5e-5, 1.5e-2));
+    paths.append(makePath("Euler", LaplaceInversion::Euler, 0, true, 1e-6, 5e-5));
+
+    FastPath noAsymptotic = makePath("Talbot, asymptotic off", LaplaceInversion::Talbot, 0, true, 1e-6, 2e-6);
+    noAsymptotic.config.asymptoticTolerance = 0.0;
+    paths.append(noAsymptotic);
+
+    // 缓存路径用 N=12: 更低阶的 Stehfest 导数由 Bourdet 差分得到，依赖时间网格，
+    // 缓存稠密网格与观测时间点上的差分结果本就不同，无法单独衡量插值误差。
+    // 定压边界晚期导数衰减过陡，插值与直接计算在窗口内的差别同样只检查符号
+    FastPath cache = makePath("Stehfest N=12 + type-curve cache", LaplaceInversion::Stehfest, 12, true, 1e-6, 7e-6);
+    cache.kind = FastPath::Cache;
+    cache.derivativeWindows = true;
+    cache.config.useTypeCurveCache = true;
+    paths.append(cache);
+
+    FastPath adaptive = makePath("Talbot + adaptive grid", LaplaceInversion::Talbot, 0, true, 1e-3, 2e-2);
+    adaptive.kind = FastPath::Adaptive;
+    paths.append(adaptive);
+
+    FastPath sensitivity = makePath("Stehfest N=8 dual-number curve", LaplaceInversion::Stehfest, 8, true, 1e-8, 1e-7);
+    sensitivity.kind = FastPath::Sensitivity;
+    paths.append(sensitivity);
+
+    const BesselFunctions::SimdLevel detected = BesselFunctions::detectSimdLevel();
+    for (int level = BesselFunctions::SimdScalar; level <= detected; ++level) {
+        const char* names[] = { "scalar", "AVX2", "AVX-512" };
+        FastPath simd = makePath(QString("Talbot, Bessel %1").arg(names[level]), LaplaceInversion::Talbot, 0, true, 1e-6, 2e-6);
+        simd.simd = level;
+        paths.append(simd);
+    }
+    return paths;
+}
+
+// 按快速路径计算一条曲线 (solver 为该模型的求解器，在同一路径的各次计算间保留，缓存因此可以命中)
+ModelCurveData evaluatePath(const FastPath& path, const GoldenCurve& golden, ModelSolver01_06& solver)
+{
+    switch (path.kind) {
+    case FastPath::Cache:
+        return solver.calculateTheoreticalCurve(golden.params, golden.t, path.config);
+    case FastPath::Adaptive: {
+        const ModelCurveData curve = solver.calculateAdaptiveCurve(ModelSolver01_06::compileParams(golden.params),
+                                                                   golden.t.first(), golden.t.last(), 1e-3, 2000, path.config);
+        return ModelSolver01_06::interpolateCurve(curve, golden.t);
+    }
+    case FastPath::Sensitivity: {
+        ModelSensitivity sens;
+        if (!solver.calculateSensitivities(golden.params, QStringList{ "kf" }, golden.t, sens, path.config)) return ModelCurveData();
+        return sens.curve;
+    }
+    case FastPath::Direct:
+    default:
+        return solver.calculateTheoreticalCurve(golden.params, golden.t, path.config);
+    }
+}
+
+// ========================================================================
+// 两种运行模式
+// ========================================================================
+int generate(const QString& dir)
+{
+    QDir().mkpath(dir);
+    for (int model = 1; model <= 6; ++model) {
+        for (int set = 1; set <= 3; ++set) {
+            GoldenCurve curve;
+            curve.model = model;
+            curve.set = set;
+            curve.params = referenceParams(model, set);
+            curve.t = ModelSolver01_06::generateLogTimeSteps(kReferencePoints, -3.0, 5.0);
+
+            ModelSolver01_06 solver(ModelSolver01_06::ModelType(model - 1));
+            const ModelCurveData ref = solver.calculateTheoreticalCurve(curve.params, curve.t,
+                                                                        referenceConfig(kReferenceMethod, kReferenceOrder));
+            const ModelCurveData cross = solver.calculateTheoreticalCurve(curve.params, curve.t,
+                                                                          referenceConfig(kCrossCheckMethod, kCrossCheckOrder));
+            curve.p = std::get<1>(ref);
+            curve.d = std::get<2>(ref);
+            curve.referenceError = std::max(maxRelativeError(std::get<1>(cross), curve.p),
+                                            maxRelativeError(std::get<2>(cross), curve.d));
+            if (!writeGolden(dir, curve)) {
+                std::fprintf(stderr, "无法写入 %s\n", qPrintable(curve.fileName()));
+                return 2;
+            }
+            std::printf("model %d set %d: reference error %.2e\n", model, set, curve.referenceError);
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
+
+int check(const QString& dir, int repeat, const QString& jsonPath)
+{
+    QVector<GoldenCurve> goldens;
+    const QStringList files = QDir(dir).entryList(QStringList{ "model*_set*.txt" }, QDir::Files, QDir::Name);
+    for (const QString& name : files) {
+        GoldenCurve curve;
+        if (readGolden(QDir(dir).filePath(name), curve)) goldens.append(curve);
+    }
+    if (goldens.isEmpty()) {
+        std::fprintf(stderr, "%s 中没有参考曲线，请先运行 --generate\n", qPrintable(dir));
+        return 2;
+    }
+    double referenceError = 0.0;
+    for (const GoldenCurve& g : goldens) referenceError = std::max(referenceError, g.referenceError);
+    std::printf("%d reference curves, reference self-consistency %.2e\n", int(goldens.size()), referenceError);
+    std::printf("Stehfest derivative windows (sign checked only):\n");
+    for (const DerivativeWindow& w : kDerivativeWindows) {
+        std::printf("  model %s set %s t = [%g, %g] h: %s\n", w.model ? qPrintable(QString::number(w.model)) : "*",
+                    w.set ? qPrintable(QString::number(w.set)) : "*", w.tMin, w.tMax, w.reason);
+    }
+    std::printf("\n");
+
+    struct Result {
+        FastPath path;
+        double errP = 0.0, errD = 0.0, ms = 0.0;
+        double boundP = 0.0, boundD = 0.0;  // 实际使用的上限
+        double goldenErr = 0.0;             // 相对参考曲线的最大误差 (用于 Pareto 比较)
+        int signErrors = 0;                 // 导数符号错误的点数 (相对参考曲线，必须为 0)
+        bool pareto = false;
+    };
+    QVector<Result> results;
+    const BesselFunctions::SimdLevel initialSimd = BesselFunctions::simdLevel();
+    for (const FastPath& path : fastPaths()) {
+        if (path.simd >= 0) BesselFunctions::setSimdLevel(BesselFunctions::SimdLevel(path.simd));
+        Result r;
+        r.path = path;
+        // 低于参考解自身误差的差别无法分辨，以参考曲线为参照的上限不低于该值
+        r.boundP = path.comparesToDirect() ? path.boundP : std::max(path.boundP, referenceError);
+        r.boundD = path.comparesToDirect() ? path.boundD : std::max(path.boundD, referenceError);
+
+        // 每个模型一个求解器，在本路径的各次计算间保留
+        std::unique_ptr<ModelSolver01_06> solvers[6];
+        for (int m = 0; m < 6; ++m) solvers[m].reset(new ModelSolver01_06(ModelSolver01_06::ModelType(m)));
+
+        // 误差: 计时之前单独计算一遍。缓存路径的这一遍同时预热缓存，
+        // 计时部分只测量命中后的平移插值 (即拟合中只改变换算参数时的情形)
+        for (const GoldenCurve& g : goldens) {
+            ModelSolver01_06& solver = *solvers[g.model - 1];
+            const ModelCurveData curve = evaluatePath(path, g, solver);
+            r.goldenErr = std::max({ r.goldenErr, maxRelativeError(std::get<1>(curve), g.p),
+                                     maxRelativeError(std::get<2>(curve), g.d) });
+            r.signErrors += countSignErrors(std::get<2>(curve), g.d);
+            QVector<bool> include(g.t.size(), true);
+            if (path.derivativeWindows) {
+                for (int i = 0; i < g.t.size(); ++i) include[i] = !inDerivativeWindow(g.model, g.set, g.t[i]);
+            }
+            if (path.comparesToDirect()) {
+                const ModelCurveData direct = solver.calculateTheoreticalCurve(g.params, g.t, path.config.withTypeCurveCache(false));
+                r.errP = std::max(r.errP, maxRelativeError(std::get<1>(curve), std::get<1>(direct)));
+                r.errD = std::max(r.errD, maxRelativeError(std::get<2>(curve), std::get<2>(direct), include));
+            } else {
+                r.errP = std::max(r.errP, maxRelativeError(std::get<1>(curve), g.p));
+                r.errD = std::max(r.errD, maxRelativeError(std::get<2>(curve), g.d, include));
+            }
+        }
+
+        QVector<double> times;
+        for (int rep = 0; rep < repeat; ++rep) {
+            QElapsedTimer timer;
+            timer.start();
+            for (const GoldenCurve& g : goldens) evaluatePath(path, g, *solvers[g.model - 1]);
+            times.append(timer.nsecsElapsed() * 1e-6);
+        }
+        std::sort(times.begin(), times.end());
+        r.ms = times[times.size() / 2];
+        BesselFunctions::setSimdLevel(initialSimd);
+        results.append(r);
+    }
+
+    // Pareto 最优: 不存在另一条路径同时更快且误差更小
+    // (缓存与自动微分路径的检查误差只含其自身部分，比较时统一使用相对参考曲线的误差)
+    for (Result& r : results) {
+        r.pareto = true;
+        for (const Result& o : results) {
+            if (o.ms < r.ms && o.goldenErr < r.goldenErr) { r.pareto = false; break; }
+        }
+    }
+
+    int failures = 0;
+    QJsonArray paths;
+    std::printf("%-34s %12s %12s %6s %12s %17s %7s %s\n", "path", "max err p", "max err p'", "p'<=0", "time(ms)", "bound p/p'", "pareto", "");
+    for (const Result& r : results) {
+        const bool ok = r.errP <= r.boundP && r.errD <= r.boundD && r.signErrors == 0;
+        if (!ok) ++failures;
+        std::printf("%-34s %12.3e %12.3e %6d %12.2f %8.1e/%8.1e %7s %s%s%s\n", qPrintable(r.path.name), r.errP, r.errD, r.signErrors, r.ms,
+                    r.boundP, r.boundD, r.pareto ? "*" : "", ok ? "ok" : "FAIL", r.path.comparesToDirect() ? " (vs direct)" : "",
+                    r.path.derivativeWindows ? " (p' outside windows)" : "");
+
+        QJsonObject item;
+        item["path"] = r.path.name;
+        item["maxRelativeErrorPressure"] = r.errP;
+        item["maxRelativeErrorDerivative"] = r.errD;
+        item["derivativeWindowsExcluded"] = r.path.derivativeWindows;
+        item["derivativeSignErrors"] = r.signErrors;
+        item["timeMs"] = r.ms;
+        item["boundPressure"] = r.boundP;
+        item["boundDerivative"] = r.boundD;
+        item["reference"] = r.path.comparesToDirect() ? "direct" : "golden";
+        item["maxRelativeErrorGolden"] = r.goldenErr;
+        item["pareto"] = r.pareto;
+        item["passed"] = ok;
+        paths.append(item);
+    }
+    std::printf("\n%s: %d of %d paths exceed their bound\n", failures ? "FAILED" : "PASSED", failures, int(results.size()));
+
+    if (!jsonPath.isEmpty()) {
+        QJsonObject root;
+        root["tool"] = "SolverAccuracy";
+        root["schema"] = 3;
+        root["referenceCurves"] = int(goldens.size());
+        root["referenceError"] = referenceError;
+        root["paths"] = paths;
+        QFile file(jsonPath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) file.write(QJsonDocument(root).toJson());
+    }
+    return failures ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QString dir = QString::fromLocal8Bit(SOLVER_ACCURACY_GOLDEN_DIR);
+    QString jsonPath;
+    bool generateMode = false;
+    int repeat = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--generate") == 0) {
+            generateMode = true;
+        } else if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            dir = QString::fromLocal8Bit(argv[++i]);
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = QString::fromLocal8Bit(argv[++i]);
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::printf("用法: SolverAccuracy [--generate] [--golden 目录] [--json 输出文件] [--repeat N]\n");
+            return 1;
+        }
+    }
+    return generateMode ? generate(dir) : check(dir, repeat, jsonPath);
+}
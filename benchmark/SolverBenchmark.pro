@@ -0,0 +1,28 @@
+# ----------------------------------------------------
+# Project: SolverBenchmark
+# Description: 模型求解器性能基准测试 (命令行程序，不含界面)
+# 用法: SolverBenchmark [--quick] [--repeat N] [--serial] [--json 输出文件]
+# ----------------------------------------------------
+
+QT += core
+QT -= gui widgets
+
+TEMPLATE = app
+TARGET = SolverBenchmark
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+# 与主工程一致的优化选项
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+win32-g++: QMAKE_CXXFLAGS += -Wa,-muse-unaligned-vector-move
+
+unix: LIBS += -lm
+win32: LIBS += -lm
+
+# 求解器由 welltest_core 静态库提供 (通过 WellTestProject.pro 统一构建)
+include(../welltest_core.pri)
+
+SOURCES += \
+           solverbenchmark.cpp
@@ -0,0 +1,403 @@
+/*
+ * solverbenchmark.cpp
+ * 文件作用: 模型求解器性能基准测试 (命令行程序)
+ * 功能描述:
+ * 1. 对 ModelSolver01_06::calculateTheoreticalCurve 在 Model_1…Model_6、裂缝条数 nf、Stehfest 阶数 N
+ *    与时间点数的组合上计时，给出中位数耗时、拉普拉斯核函数计算速率与每次调用的堆分配次数。
+ * 2. 单独计时核函数 PWD_composite (不含井储) 与 flaplace_composite (含井储表皮)，实轴与复数节点各一组。
+ * 3. 计时 PressureDerivativeCalculator::calculateBourdetDerivative。
+ * 4. 结果同时输出为可读表格与 JSON (--json 文件名，"-" 表示标准输出)，便于不同版本之间对比。
+ * 5. 堆分配计数: glibc 下替换 malloc / calloc / realloc (Qt 容器直接使用 malloc)，
+ *    其余平台替换 operator new (此时 Qt 容器的分配不计入)，JSON 中注明计数方式。
+ */
+
+#include "modelsolver01-06.h"
+#include "besselfunctions.h"
+#include "pressurederivativecalculator.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// ========================================================================
+// 堆分配计数
+// ========================================================================
+namespace {
+std::atomic<qint64> g_allocations(0);
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+static const char* kAllocationCounter = "malloc";
+#else
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+static const char* kAllocationCounter = "operator new";
+#endif
+
+namespace {
+
+// ========================================================================
+// 运行选项
+// ========================================================================
+struct BenchOptions {
+    QVector<int> models = { 1, 2, 3, 4, 5, 6 };
+    QVector<int> fractures = { 1, 4, 16, 32 };
+    QVector<int> orders = { 4, 8, 12, 16 };
+    QVector<int> points = { 100, 500, 1000, 5000 };
+    int repeat = 5;
+    bool parallel = true;
+    QString jsonPath;
+};
+
+// 逗号分隔的整数列表
+QVector<int> parseList(const char* text)
+{
+    QVector<int> values;
+    for (const QString& item : QString::fromLocal8Bit(text).split(',')) {
+        bool ok = false;
+        const int v = item.trimmed().toInt(&ok);
+        if (ok) values.append(v);
+    }
+    return values;
+}
+
+void printUsage()
+{
+    std::printf("用法: SolverBenchmark [选项]\n"
+                "  --quick            缩减组合 (nf 1,4,16; N 8; 点数 100,1000; 重复 3 次)\n"
+                "  --models 1,2,...   模型编号 (1-6)\n"
+                "  --nf 1,4,16,32     裂缝条数\n"
+                "  --N 4,8,12,16      Stehfest 阶数\n"
+                "  --points 100,5000  时间点数\n"
+                "  --repeat N         每个组合的重复次数 (取中位数)\n"
+                "  --serial           关闭节点并行计算\n"
+                "  --json 文件名      输出 JSON 结果 (\"-\" 为标准输出)\n");
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--quick") == 0) {
+            opt.fractures = { 1, 4, 16 };
+            opt.orders = { 8 };
+            opt.points = { 100, 1000 };
+            opt.repeat = 3;
+        } else if (std::strcmp(arg, "--models") == 0 && hasValue) {
+            opt.models = parseList(argv[++i]);
+        } else if (std::strcmp(arg, "--nf") == 0 && hasValue) {
+            opt.fractures = parseList(argv[++i]);
+        } else if (std::strcmp(arg, "--N") == 0 && hasValue) {
+            opt.orders = parseList(argv[++i]);
+        } else if (std::strcmp(arg, "--points") == 0 && hasValue) {
+            opt.points = parseList(argv[++i]);
+        } else if (std::strcmp(arg, "--repeat") == 0 && hasValue) {
+            opt.repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--serial") == 0) {
+            opt.parallel = false;
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            opt.jsonPath = QString::fromLocal8Bit(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ========================================================================
+// 测试参数与计时工具
+// ========================================================================
+
+// 与 ModelManager::getDefaultParameters 一致的参数组；
+// 裂缝半长不超过 0.4 倍裂缝间距，nf = 16、32 时裂缝也互不重叠
+QMap<QString, double> benchmarkParams(int model, int nf, int order)
+{
+    QMap<QString, double> p;
+    p.insert("phi", 0.05);
+    p.insert("h", 20.0);
+    p.insert("mu", 0.5);
+    p.insert("B", 1.05);
+    p.insert("Ct", 5e-4);
+    p.insert("q", 5.0);
+    p.insert("nf", nf);
+    p.insert("kf", 1e-3);
+    p.insert("km", 1e-4);
+    p.insert("L", 1000.0);
+    const double spacing = nf > 1 ? 1800.0 / (nf - 1) : 1e300;
+    p.insert("Lf", std::min(100.0, 0.4 * spacing));
+    p.insert("rmD", 4.0);
+    p.insert("omega1", 0.4);
+    p.insert("omega2", 0.08);
+    p.insert("lambda1", 1e-3);
+    p.insert("gamaD", 0.02);
+    const bool storage = (model % 2 == 1);
+    p.insert("cD", storage ? 0.01 : 0.0);
+    p.insert("S", storage ? 1.0 : 0.0);
+    if (model >= 3) p.insert("reD", 10.0);
+    p.insert("N", order);
+    return p;
+}
+
+double median(QVector<double> values)
+{
+    if (values.isEmpty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const int n = values.size();
+    return (n % 2) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+const char* simdName(BesselFunctions::SimdLevel level)
+{
+    switch (level) {
+    case BesselFunctions::SimdAvx512: return "avx512";
+    case BesselFunctions::SimdAvx2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+// 单项计时结果: 各次耗时 (ns)、计时期间的分配次数与核函数计算次数
+struct Timing {
+    QVector<double> nanoseconds;
+    qint64 allocations = 0;
+    qint64 evaluations = 0;
+};
+
+// 预热一次后重复 repeat 次
+template <typename Body>
+Timing measure(int repeat, const Body& body)
+{
+    body();
+    Timing timing;
+    const qint64 alloc0 = g_allocations.load(std::memory_order_relaxed);
+    const qint64 eval0 = ModelSolver01_06::laplaceEvaluationCount();
+    for (int r = 0; r < repeat; ++r) {
+        QElapsedTimer timer;
+        timer.start();
+        body();
+        timing.nanoseconds.append(double(timer.nsecsElapsed()));
+    }
+    timing.allocations = g_allocations.load(std::memory_order_relaxed) - alloc0;
+    timing.evaluations = ModelSolver01_06::laplaceEvaluationCount() - eval0;
+    return timing;
+}
+
+// ========================================================================
+// 各项基准
+// ========================================================================
+
+// 理论曲线: 时间范围 1e-3 ~ 1e3 h
+QJsonArray benchmarkCurves(const BenchOptions& opt, const SolverConfig& config)
+{
+    QJsonArray results;
+    std::printf("\n[calculateTheoreticalCurve]\n%-6s %4s %4s %7s %12s %12s %14s %12s\n",
+                "model", "nf", "N", "points", "median(ms)", "min(ms)", "evals/s", "allocs/call");
+    for (int model : opt.models) {
+        ModelSolver01_06 solver(ModelSolver01_06::ModelType(model - 1));
+        for (int nf : opt.fractures) {
+            for (int order : opt.orders) {
+                const ModelParams params = ModelSolver01_06::compileParams(benchmarkParams(model, nf, order));
+                for (int points : opt.points) {
+                    const QVector<double> t = ModelSolver01_06::generateLogTimeSteps(points, -3.0, 3.0);
+                    const Timing timing = measure(opt.repeat, [&]() {
+                        solver.calculateTheoreticalCurve(params, t, config);
+                    });
+                    const double med = median(timing.nanoseconds);
+                    const double minimum = *std::min_element(timing.nanoseconds.begin(), timing.nanoseconds.end());
+                    const double evalsPerCall = double(timing.evaluations) / opt.repeat;
+                    const double evalsPerSecond = med > 0.0 ? evalsPerCall / (med * 1e-9) : 0.0;
+                    const double allocsPerCall = double(timing.allocations) / opt.repeat;
+                    std::printf("%-6d %4d %4d %7d %12.3f %12.3f %14.4g %12.1f\n",
+                                model, nf, order, points, med * 1e-6, minimum * 1e-6, evalsPerSecond, allocsPerCall);
+                    std::fflush(stdout);
+
+                    QJsonObject item;
+                    item["model"] = model;
+                    item["nf"] = nf;
+                    item["N"] = order;
+                    item["points"] = points;
+                    item["medianMs"] = med * 1e-6;
+                    item["minMs"] = minimum * 1e-6;
+                    item["laplaceEvaluations"] = evalsPerCall;
+                    item["evaluationsPerSecond"] = evalsPerSecond;
+                    item["allocations"] = allocsPerCall;
+                    results.append(item);
+                }
+            }
+        }
+    }
+    return results;
+}
+
+// 核函数: 64 个对数分布的节点 (1e-2 ~ 1e8)，复数节点取 s·(1 + i)
+QJsonArray benchmarkKernels(const BenchOptions& opt, const SolverConfig& config)
+{
+    const int kNodes = 64;
+    QVector<LaplaceInversion::Complex> realNodes, complexNodes;
+    for (int k = 0; k < kNodes; ++k) {
+        const double s = std::pow(10.0, -2.0 + 10.0 * k / (kNodes - 1));
+        realNodes.append(LaplaceInversion::Complex(s, 0.0));
+        complexNodes.append(LaplaceInversion::Complex(s, s));
+    }
+
+    QJsonArray results;
+    std::printf("\n[kernel]\n%-18s %-8s %-6s %4s %14s %14s %14s\n",
+                "function", "nodes", "model", "nf", "ns/eval", "evals/s", "allocs/eval");
+    for (int model : opt.models) {
+        ModelSolver01_06 solver(ModelSolver01_06::ModelType(model - 1));
+        for (int nf : opt.fractures) {
+            const ModelParams params = ModelSolver01_06::compileParams(benchmarkParams(model, nf, 8));
+            for (int withStorage = 0; withStorage < 2; ++withStorage) {
+                for (int complexCase = 0; complexCase < 2; ++complexCase) {
+                    const QVector<LaplaceInversion::Complex>& nodes = complexCase ? complexNodes : realNodes;
+                    volatile double sink = 0.0;
+                    const Timing timing = measure(opt.repeat, [&]() {
+                        for (const LaplaceInversion::Complex& s : nodes) {
+                            sink = sink + solver.laplaceValue(s, params, config, withStorage != 0).real();
+                        }
+                    });
+                    const double nsPerEval = median(timing.nanoseconds) / kNodes;
+                    const double allocsPerEval = double(timing.allocations) / (double(opt.repeat) * kNodes);
+                    const char* function = withStorage ? "flaplace_composite" : "PWD_composite";
+                    std::printf("%-18s %-8s %-6d %4d %14.1f %14.4g %14.2f\n", function, complexCase ? "complex" : "real",
+                                model, nf, nsPerEval, 1e9 / nsPerEval, allocsPerEval);
+                    std::fflush(stdout);
+
+                    QJsonObject item;
+                    item["function"] = QString::fromLatin1(function);
+                    item["complexNodes"] = complexCase != 0;
+                    item["model"] = model;
+                    item["nf"] = nf;
+                    item["nsPerEvaluation"] = nsPerEval;
+                    item["evaluationsPerSecond"] = 1e9 / nsPerEval;
+                    item["allocationsPerEvaluation"] = allocsPerEval;
+                    results.append(item);
+                }
+            }
+        }
+    }
+    return results;
+}
+
+// Bourdet 导数: 压差取模型 1 的理论曲线，L-Spacing = 0.1
+QJsonArray benchmarkBourdet(const BenchOptions& opt)
+{
+    QJsonArray results;
+    std::printf("\n[calculateBourdetDerivative]\n%7s %12s %12s\n", "points", "median(ms)", "allocs/call");
+    ModelSolver01_06 solver(ModelSolver01_06::Model_1);
+    const ModelParams params = ModelSolver01_06::compileParams(benchmarkParams(1, 4, 8));
+    for (int points : opt.points) {
+        const ModelCurveData curve = solver.calculateTheoreticalCurve(params, ModelSolver01_06::generateLogTimeSteps(points, -3.0, 3.0));
+        const QVector<double>& t = std::get<0>(curve);
+        const QVector<double>& dp = std::get<1>(curve);
+        const Timing timing = measure(opt.repeat, [&]() {
+            PressureDerivativeCalculator::calculateBourdetDerivative(t, dp, 0.1);
+        });
+        const double med = median(timing.nanoseconds);
+        const double allocsPerCall = double(timing.allocations) / opt.repeat;
+        std::printf("%7d %12.4f %12.1f\n", points, med * 1e-6, allocsPerCall);
+
+        QJsonObject item;
+        item["points"] = points;
+        item["medianMs"] = med * 1e-6;
+        item["allocations"] = allocsPerCall;
+        results.append(item);
+    }
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchOptions opt;
+    if (!parseOptions(argc, argv, opt)) {
+        printUsage();
+        return 1;
+    }
+
+    SolverConfig config;
+    config.parallel = opt.parallel;
+
+    std::printf("SolverBenchmark: threads %d, parallel %s, simd %s, repeat %d, allocation counter %s\n",
+                QThread::idealThreadCount(), opt.parallel ? "on" : "off",
+                simdName(BesselFunctions::simdLevel()), opt.repeat, kAllocationCounter);
+
+    QJsonObject root;
+    root["tool"] = "SolverBenchmark";
+    root["schema"] = 1;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["threads"] = QThread::idealThreadCount();
+    root["parallel"] = opt.parallel;
+    root["simd"] = QString::fromLatin1(simdName(BesselFunctions::simdLevel()));
+    root["repeat"] = opt.repeat;
+    root["allocationCounter"] = QString::fromLatin1(kAllocationCounter);
+    root["curves"] = benchmarkCurves(opt, config);
+    root["kernels"] = benchmarkKernels(opt, config);
+    root["bourdet"] = benchmarkBourdet(opt);
+
+    if (!opt.jsonPath.isEmpty()) {
+        const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+        if (opt.jsonPath == "-") {
+            std::fwrite(json.constData(), 1, json.size(), stdout);
+        } else {
+            QFile file(opt.jsonPath);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                std::fprintf(stderr, "无法写入 %s\n", qPrintable(opt.jsonPath));
+                return 2;
+            }
+            file.write(json);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,435 @@
+/*
+ * besselfunctions.cpp
+ * 文件作用: 修正 Bessel 函数计算模块实现
+ * 功能描述:
+ * 1. 实数版本采用 Chebyshev 逼近 (besselkernels.h) 的标量实现；批量接口按检测到的指令集
+ *    分派到 AVX-512 / AVX2 / 标量实现，SIMD 实现位于 besselfunctions_avx2.cpp、besselfunctions_avx512.cpp。
+ * 2. 复数版本根据 |z| 分区计算：
+ *    - |z| <= 2  : 幂级数 (A&S 9.6.10 / 9.6.11)；
+ *    - |z| > 2   : K0、K1 用 Steed 连分式 CF2 (Temme 方法)，I0、I1 用比值连分式 CF1 结合
+ *                  Wronski 关系 I0·K1 + I1·K0 = 1/z 得到；
+ *    - |z| > 50  : I0、I1 改用包含指数小项的完整渐近展开 (DLMF 10.40.5)。
+ *    所有结果均以指数缩放形式计算，避免大参数时上溢/下溢。
+ */
+
+#include "besselfunctions.h"
+
+#include <QAtomicInt>
+#include <cmath>
+
+#include "besselkernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+const double kEulerGamma = 0.57721566490153286061;
+const double kEps = 1e-16;
+const double kTiny = 1e-300;
+const int kMaxIter = 10000;
+}
+
+// ============================================================================
+// 标量运算 (供 besselkernels.h 中的通用算法使用)
+// ============================================================================
+
+namespace {
+
+struct ScalarOps
+{
+    using V = double;
+    using M = bool;
+    enum { Width = 1 };
+    static V set1(double v) { return v; }
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V fmadd(V a, V b, V c) { return a * b + c; }
+    static V abs(V a) { return std::abs(a); }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V exp(V a) { return std::exp(a); }
+    static V log(V a) { return std::log(a); }
+    static M le(V a, V b) { return a <= b; }
+    static M lt(V a, V b) { return a < b; }
+    static bool any(M m) { return m; }
+    static bool all(M m) { return m; }
+    static V blend(M m, V ifTrue, V ifFalse) { return m ? ifTrue : ifFalse; }
+};
+
+enum BatchFunc { FuncK0 = 0, FuncK1, FuncI0e, FuncI1e };
+
+QAtomicInt g_simdLevel(-1); // -1 表示尚未检测
+
+}
+
+// ============================================================================
+// 实数版本
+// ============================================================================
+
+double BesselFunctions::besselK0(double x)
+{
+    return BesselKernels::k0<ScalarOps>(x);
+}
+
+double BesselFunctions::besselK1(double x)
+{
+    return BesselKernels::k1<ScalarOps>(x);
+}
+
+double BesselFunctions::besselI0Scaled(double x)
+{
+    return BesselKernels::i0e<ScalarOps>(x);
+}
+
+double BesselFunctions::besselI1Scaled(double x)
+{
+    return BesselKernels::i1e<ScalarOps>(x);
+}
+
+// ============================================================================
+// 实数批量版本与指令集分派
+// ============================================================================
+
+void BesselFunctions::besselK0Batch(const double* x, double* out, int n)
+{
+    dispatchBatch(FuncK0, x, out, n);
+}
+
+void BesselFunctions::besselK1Batch(const double* x, double* out, int n)
+{
+    dispatchBatch(FuncK1, x, out, n);
+}
+
+void BesselFunctions::besselI0ScaledBatch(const double* x, double* out, int n)
+{
+    dispatchBatch(FuncI0e, x, out, n);
+}
+
+void BesselFunctions::besselI1ScaledBatch(const double* x, double* out, int n)
+{
+    dispatchBatch(FuncI1e, x, out, n);
+}
+
+void BesselFunctions::batchScalar(int func, const double* x, double* out, int n)
+{
+    using namespace BesselKernels;
+    switch (func) {
+    case FuncK0:  batch<ScalarOps>(x, out, n, k0<ScalarOps>); break;
+    case FuncK1:  batch<ScalarOps>(x, out, n, k1<ScalarOps>); break;
+    case FuncI0e: batch<ScalarOps>(x, out, n, i0e<ScalarOps>); break;
+    case FuncI1e: batch<ScalarOps>(x, out, n, i1e<ScalarOps>); break;
+    default: break;
+    }
+}
+
+void BesselFunctions::dispatchBatch(int func, const double* x, double* out, int n)
+{
+    if (n <= 0) return;
+    switch (simdLevel()) {
+    case SimdAvx512: batchAvx512(func, x, out, n); break;
+    case SimdAvx2:   batchAvx2(func, x, out, n); break;
+    default:         batchScalar(func, x, out, n); break;
+    }
+}
+
+BesselFunctions::SimdLevel BesselFunctions::detectSimdLevel()
+{
+#if defined(BESSEL_NO_SIMD)
+    return SimdScalar;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // __builtin_cpu_supports 同时检查 CPU 标志与操作系统对 YMM/ZMM 寄存器状态的支持
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdAvx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdAvx2;
+    return SimdScalar;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return SimdScalar;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if (!osxsave) return SimdScalar;
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    const bool avx512f = (info[1] & (1 << 16)) != 0;
+    if (avx512f && (xcr0 & 0xE6) == 0xE6) return SimdAvx512;
+    if (avx2 && fma && (xcr0 & 0x6) == 0x6) return SimdAvx2;
+    return SimdScalar;
+#else
+    return SimdScalar;
+#endif
+}
+
+BesselFunctions::SimdLevel BesselFunctions::simdLevel()
+{
+    int level = g_simdLevel.loadAcquire();
+    if (level < 0) {
+        level = detectSimdLevel();
+        g_simdLevel.storeRelease(level);
+    }
+    return SimdLevel(level);
+}
+
+void BesselFunctions::setSimdLevel(SimdLevel level)
+{
+    const SimdLevel supported = detectSimdLevel();
+    if (level > supported) level = supported;
+    g_simdLevel.storeRelease(level);
+}
+
+// ============================================================================
+// 复数版本
+// ============================================================================
+
+BesselFunctions::Complex BesselFunctions::besselK0(const Complex& z)
+{
+    if (z.imag() == 0.0 && z.real() > 0.0) return Complex(besselK0(z.real()), 0.0);
+    Complex k0e, k1e, i0e, i1e;
+    complexBesselScaled(z, ComplexK, k0e, k1e, i0e, i1e);
+    return k0e * std::exp(-z);
+}
+
+BesselFunctions::Complex BesselFunctions::besselK1(const Complex& z)
+{
+    if (z.imag() == 0.0 && z.real() > 0.0) return Complex(besselK1(z.real()), 0.0);
+    Complex k0e, k1e, i0e, i1e;
+    complexBesselScaled(z, ComplexK, k0e, k1e, i0e, i1e);
+    return k1e * std::exp(-z);
+}
+
+BesselFunctions::Complex BesselFunctions::besselI0Scaled(const Complex& z)
+{
+    if (z.imag() == 0.0 && z.real() >= 0.0) return Complex(besselI0Scaled(z.real()), 0.0);
+    Complex k0e, k1e, i0e, i1e;
+    complexBesselScaled(z, ComplexI, k0e, k1e, i0e, i1e);
+    return i0e;
+}
+
+BesselFunctions::Complex BesselFunctions::besselI1Scaled(const Complex& z)
+{
+    if (z.imag() == 0.0 && z.real() >= 0.0) return Complex(besselI1Scaled(z.real()), 0.0);
+    Complex k0e, k1e, i0e, i1e;
+    complexBesselScaled(z, ComplexI, k0e, k1e, i0e, i1e);
+    return i1e;
+}
+
+void BesselFunctions::besselK0K1(const Complex& z, Complex& k0, Complex& k1)
+{
+    if (z.imag() == 0.0 && z.real() > 0.0) {
+        k0 = Complex(besselK0(z.real()), 0.0);
+        k1 = Complex(besselK1(z.real()), 0.0);
+        return;
+    }
+    Complex k0e, k1e, i0e, i1e;
+    complexBesselScaled(z, ComplexK, k0e, k1e, i0e, i1e);
+    const Complex emz = std::exp(-z);
+    k0 = k0e * emz;
+    k1 = k1e * emz;
+}
+
+void BesselFunctions::besselI0I1Scaled(const Complex& z, Complex& i0e, Complex& i1e)
+{
+    if (z.imag() == 0.0 && z.real() >= 0.0) {
+        i0e = Complex(besselI0Scaled(z.real()), 0.0);
+        i1e = Complex(besselI1Scaled(z.real()), 0.0);
+        return;
+    }
+    Complex k0e, k1e;
+    complexBesselScaled(z, ComplexI, k0e, k1e, i0e, i1e);
+}
+
+void BesselFunctions::besselK0I0Scaled(const Complex& z, Complex& k0, Complex& i0e)
+{
+    if (z.imag() == 0.0 && z.real() > 0.0) {
+        k0 = Complex(besselK0(z.real()), 0.0);
+        i0e = Complex(besselI0Scaled(z.real()), 0.0);
+        return;
+    }
+    Complex k0e, k1e, i1e;
+    complexBesselScaled(z, ComplexKI, k0e, k1e, i0e, i1e);
+    k0 = k0e * std::exp(-z);
+}
+
+// 统一计算入口 (按 |z| 分区)
+void BesselFunctions::complexBesselScaled(const Complex& z, int parts, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e)
+{
+    const double az = std::abs(z);
+    if (az <= 2.0) {
+        // 小参数：幂级数 (K 的级数本身需要 I 的部分和，四个函数一起得到)，再乘以指数因子得到缩放值
+        Complex k0, k1, i0, i1;
+        complexSeries(z, k0, k1, i0, i1);
+        Complex ez = std::exp(z);
+        Complex emz = std::exp(-z);
+        k0e = k0 * ez;
+        k1e = k1 * ez;
+        i0e = i0 * emz;
+        i1e = i1 * emz;
+        return;
+    }
+
+    // 中、大参数：K 由 Steed 连分式给出 (本身即为缩放形式)；
+    // 中等参数的 I 经由 Wronski 关系也需要 K，只有大参数下单独求 I 时才可跳过
+    const bool wantI = (parts & ComplexI) != 0;
+    if ((parts & ComplexK) || (wantI && az <= 50.0)) complexSteedK(z, k0e, k1e);
+    if (!wantI) return;
+
+    if (az > 50.0) {
+        complexAsymptoticI(z, i0e, i1e);
+    } else {
+        // Wronski 关系: I0 K1 + I1 K0 = 1/z, I1 = R·I0  =>  I0 = 1 / (z (K1 + R K0))
+        // 两边同乘缩放因子后: e^-z I0 = 1 / (z (e^z K1 + R e^z K0))
+        Complex R = complexRatioI1I0(z);
+        i0e = 1.0 / (z * (k1e + R * k0e));
+        i1e = R * i0e;
+    }
+}
+
+// 幂级数 (|z| <= 2)
+// I0 = Σ t^k/(k!)^2, I1 = (z/2) Σ t^k/(k!(k+1)!), t = z^2/4
+// K0 = -(ln(z/2)+γ) I0 + Σ H_k t^k/(k!)^2
+// K1 = 1/z + ln(z/2) I1 - (z/4) Σ [ψ(k+1)+ψ(k+2)] t^k/(k!(k+1)!)
+void BesselFunctions::complexSeries(const Complex& z, Complex& k0, Complex& k1, Complex& i0, Complex& i1)
+{
+    const Complex t = 0.25 * z * z;
+    const Complex lnHalfZ = std::log(0.5 * z);
+
+    Complex term0(1.0, 0.0);  // t^k/(k!)^2
+    Complex term1(1.0, 0.0);  // t^k/(k!(k+1)!)
+    Complex sumI0 = term0;
+    Complex sumI1 = term1;
+    Complex sumK0(0.0, 0.0);
+    double harmonic = 0.0;                    // H_k
+    Complex sumK1 = (-2.0 * kEulerGamma + 1.0) * term1; // ψ(1)+ψ(2) = -2γ + 1
+
+    for (int k = 1; k < 200; ++k) {
+        term0 *= t / double(k * k);
+        term1 *= t / double(k * (k + 1));
+        harmonic += 1.0 / k;
+        const double psiSum = -2.0 * kEulerGamma + 2.0 * harmonic + 1.0 / (k + 1); // ψ(k+1)+ψ(k+2)
+
+        sumI0 += term0;
+        sumI1 += term1;
+        sumK0 += harmonic * term0;
+        sumK1 += psiSum * term1;
+
+        if (std::abs(term0) * (1.0 + harmonic) < kEps * std::abs(sumI0)
+            && std::abs(term1) * (1.0 + psiSum) < kEps * std::abs(sumI1)) {
+            break;
+        }
+    }
+
+    i0 = sumI0;
+    i1 = 0.5 * z * sumI1;
+    k0 = -(lnHalfZ + kEulerGamma) * i0 + sumK0;
+    k1 = 1.0 / z + lnHalfZ * i1 - 0.25 * z * sumK1;
+}
+
+// Steed 连分式 CF2 (Temme)：给出 e^z K0(z) 与 e^z K1(z)，适用于 |z| > 2, Re z >= 0
+void BesselFunctions::complexSteedK(const Complex& z, Complex& k0e, Complex& k1e)
+{
+    const double a1 = 0.25;     // 1/4 - ν^2, ν = 0
+    Complex b = 2.0 * (1.0 + z);
+    Complex d = 1.0 / b;
+    Complex h = d;
+    Complex delh = d;
+    Complex q1(0.0, 0.0);
+    Complex q2(1.0, 0.0);
+    Complex q(a1, 0.0);
+    Complex c(a1, 0.0);
+    double a = -a1;
+    Complex s = 1.0 + q * delh;
+
+    for (int i = 1; i < kMaxIter; ++i) {
+        a -= 2 * i;
+        c = -a * c / (i + 1.0);
+        Complex qnew = (q1 - b * q2) / a;
+        q1 = q2;
+        q2 = qnew;
+        q += c * qnew;
+        b += 2.0;
+        d = 1.0 / (b + a * d);
+        delh = (b * d - 1.0) * delh;
+        h += delh;
+        Complex dels = q * delh;
+        s += dels;
+        if (std::abs(dels) < kEps * std::abs(s)) break;
+    }
+    h = a1 * h;
+
+    k0e = std::sqrt(M_PI / (2.0 * z)) / s;
+    k1e = k0e * (z + 0.5 - h) / z;
+}
+
+// 比值连分式 CF1: I1(z)/I0(z) = 1/(2/z + 1/(4/z + 1/(6/z + ...)))，改进 Lentz 算法
+BesselFunctions::Complex BesselFunctions::complexRatioI1I0(const Complex& z)
+{
+    const Complex zInv = 1.0 / z;
+    Complex f = 2.0 * zInv;
+    if (std::abs(f) < kTiny) f = kTiny;
+    Complex C = f;
+    Complex D(0.0, 0.0);
+
+    for (int j = 2; j < kMaxIter; ++j) {
+        const Complex bj = 2.0 * j * zInv;
+        D = bj + D;
+        if (std::abs(D) < kTiny) D = kTiny;
+        C = bj + 1.0 / C;
+        if (std::abs(C) < kTiny) C = kTiny;
+        D = 1.0 / D;
+        const Complex delta = C * D;
+        f *= delta;
+        if (std::abs(delta - 1.0) < kEps) break;
+    }
+    return 1.0 / f;
+}
+
+// 大参数渐近展开 (DLMF 10.40.5)，包含 Im z ≠ 0 时不可忽略的 e^{-2z} 项
+// e^-z I_v(z) ~ [Σ(-1)^k a_k(v)/z^k ± i e^{±ivπ} e^{-2z} Σ a_k(v)/z^k] / sqrt(2πz)
+void BesselFunctions::complexAsymptoticI(const Complex& z, Complex& i0e, Complex& i1e)
+{
+    const Complex zInv = 1.0 / z;
+    Complex sumAlt0(1.0, 0.0), sumPos0(1.0, 0.0);
+    Complex sumAlt1(1.0, 0.0), sumPos1(1.0, 0.0);
+    Complex term0(1.0, 0.0), term1(1.0, 0.0);
+    double prevMag0 = 1.0, prevMag1 = 1.0;
+
+    for (int k = 1; k < 60; ++k) {
+        const double odd = 2.0 * k - 1.0;
+        // a_k(v) = a_{k-1}(v) * (4v^2 - (2k-1)^2) / (8k)
+        Complex next0 = term0 * ((0.0 - odd * odd) / (8.0 * k)) * zInv;
+        Complex next1 = term1 * ((4.0 - odd * odd) / (8.0 * k)) * zInv;
+        const double mag0 = std::abs(next0);
+        const double mag1 = std::abs(next1);
+        // 渐近级数在最小项处截断
+        if (mag0 > prevMag0 || mag1 > prevMag1) break;
+        term0 = next0;
+        term1 = next1;
+        const double sign = (k % 2 == 0) ? 1.0 : -1.0;
+        sumAlt0 += sign * term0;
+        sumPos0 += term0;
+        sumAlt1 += sign * term1;
+        sumPos1 += term1;
+        prevMag0 = mag0;
+        prevMag1 = mag1;
+        if (mag0 < kEps && mag1 < kEps) break;
+    }
+
+    const Complex pre = 1.0 / std::sqrt(2.0 * M_PI * z);
+    const Complex e2z = std::exp(-2.0 * z);
+    // v = 0: ± i e^{-2z};  v = 1: e^{±iπ} = -1，故为 ∓ i e^{-2z}
+    const Complex iSign = (z.imag() >= 0.0) ? Complex(0.0, 1.0) : Complex(0.0, -1.0);
+    i0e = pre * (sumAlt0 + iSign * e2z * sumPos0);
+    i1e = pre * (sumAlt1 - iSign * e2z * sumPos1);
+}
@@ -0,0 +1,112 @@
+/*
+ * besselfunctions.h
+ * 文件作用: 修正 Bessel 函数计算模块头文件
+ * 功能描述:
+ * 1. 提供模型核函数所需的第二类修正 Bessel 函数 K0、K1 以及指数缩放的第一类修正 Bessel 函数
+ *    I0(x)·e^(-x)、I1(x)·e^(-x)。
+ * 2. 实数版本用于 Stehfest 等实数拉普拉斯节点的反演方法，采用 Chebyshev 逼近 (见 besselkernels.h)，
+ *    I0、I1 直接以指数缩放形式计算，大参数不溢出。
+ *    另提供批量接口 (一次计算裂缝积分的全部求积节点)，运行时按 CPU 支持情况选择
+ *    AVX-512 / AVX2 / 标量实现。
+ * 3. 复数版本 (主值分支，Re z >= 0) 用于 Talbot、de Hoog、Euler 等复数节点反演方法：
+ *    |z| <= 2 采用幂级数，|z| > 2 采用 Steed 连分式 (K) 与比值连分式 + Wronski 关系 (I)，
+ *    |z| 很大时采用渐近展开。只需 K 或只需 I 时跳过另一组函数独有的计算；同一参数需要两个函数时
+ *    使用成对接口 (besselK0K1 等)，只计算一次。
+ * 4. 对偶数版本 (dualnumber.h) 由实数函数值按导数关系组合，用于核函数的前向自动微分。
+ */
+
+#ifndef BESSELFUNCTIONS_H
+#define BESSELFUNCTIONS_H
+
+#include <complex>
+#include "dualnumber.h"
+
+class BesselFunctions
+{
+public:
+    using Complex = std::complex<double>;
+
+    // ---------------- 实数版本 ----------------
+    static double besselK0(double x);
+    static double besselK1(double x);
+    // 指数缩放: I_v(x) * exp(-|x|)，大参数时不溢出
+    static double besselI0Scaled(double x);
+    static double besselI1Scaled(double x);
+
+    // ---------------- 实数批量版本 ----------------
+    // out[i] = f(x[i])，i = 0..n-1 (x 与 out 可以是同一数组)
+    static void besselK0Batch(const double* x, double* out, int n);
+    static void besselK1Batch(const double* x, double* out, int n);
+    static void besselI0ScaledBatch(const double* x, double* out, int n);
+    static void besselI1ScaledBatch(const double* x, double* out, int n);
+
+    // 批量接口使用的指令集
+    enum SimdLevel {
+        SimdScalar = 0, // 标量实现
+        SimdAvx2,       // AVX2 + FMA (4 路)
+        SimdAvx512      // AVX-512F (8 路)
+    };
+    // CPU 与操作系统支持的最高指令集
+    static SimdLevel detectSimdLevel();
+    // 当前使用的指令集 (首次调用时自动检测)
+    static SimdLevel simdLevel();
+    // 指定指令集 (用于性能对比与结果校验)，超出 CPU 支持范围时自动降级
+    static void setSimdLevel(SimdLevel level);
+
+    // ---------------- 复数版本 ----------------
+    static Complex besselK0(const Complex& z);
+    static Complex besselK1(const Complex& z);
+    // 指数缩放: I_v(z) * exp(-z)
+    static Complex besselI0Scaled(const Complex& z);
+    static Complex besselI1Scaled(const Complex& z);
+    // 同一参数的成对计算: 共用一次级数/连分式计算 (单独调用上面的函数时每次都要重新计算)
+    static void besselK0K1(const Complex& z, Complex& k0, Complex& k1);
+    static void besselI0I1Scaled(const Complex& z, Complex& i0e, Complex& i1e);
+    static void besselK0I0Scaled(const Complex& z, Complex& k0, Complex& i0e);
+
+    // 成对计算的实数与对偶数版本 (供按 Scalar 类型实例化的核函数统一调用)，逐个计算即可
+    template <typename T>
+    static void besselK0K1(const T& x, T& k0, T& k1) { k0 = besselK0(x); k1 = besselK1(x); }
+    template <typename T>
+    static void besselI0I1Scaled(const T& x, T& i0e, T& i1e) { i0e = besselI0Scaled(x); i1e = besselI1Scaled(x); }
+    template <typename T>
+    static void besselK0I0Scaled(const T& x, T& k0, T& i0e) { k0 = besselK0(x); i0e = besselI0Scaled(x); }
+
+    // ---------------- 对偶数版本 (前向自动微分) ----------------
+    // K0' = -K1，K1' = -K0 - K1/x，(e^-x·I0)' = e^-x·I1 - e^-x·I0，(e^-x·I1)' = e^-x·I0 - (1 + 1/x)·e^-x·I1
+    template <int N>
+    static Dual<N> besselK0(const Dual<N>& x) { return dualApply(x, besselK0(x.v), -besselK1(x.v)); }
+    template <int N>
+    static Dual<N> besselK1(const Dual<N>& x) {
+        const double k1 = besselK1(x.v);
+        return dualApply(x, k1, -besselK0(x.v) - k1 / x.v);
+    }
+    template <int N>
+    static Dual<N> besselI0Scaled(const Dual<N>& x) {
+        const double i0s = besselI0Scaled(x.v);
+        return dualApply(x, i0s, besselI1Scaled(x.v) - i0s);
+    }
+    template <int N>
+    static Dual<N> besselI1Scaled(const Dual<N>& x) {
+        const double i1s = besselI1Scaled(x.v);
+        return dualApply(x, i1s, besselI0Scaled(x.v) - (1.0 + 1.0 / x.v) * i1s);
+    }
+
+private:
+    // 各指令集的批量实现 (分别位于 besselfunctions.cpp / _avx2.cpp / _avx512.cpp)
+    static void batchScalar(int func, const double* x, double* out, int n);
+    static void batchAvx2(int func, const double* x, double* out, int n);
+    static void batchAvx512(int func, const double* x, double* out, int n);
+    static void dispatchBatch(int func, const double* x, double* out, int n);
+
+    // 复数 Bessel 函数的统一计算入口：得到 e^z K0、e^z K1、e^-z I0、e^-z I1，
+    // wantK / wantI 为假时跳过只有对应函数才需要的连分式或渐近展开 (未计算的输出不作修改)
+    enum ComplexParts { ComplexK = 1, ComplexI = 2, ComplexKI = 3 };
+    static void complexBesselScaled(const Complex& z, int parts, Complex& k0e, Complex& k1e, Complex& i0e, Complex& i1e);
+    static void complexSeries(const Complex& z, Complex& k0, Complex& k1, Complex& i0, Complex& i1);
+    static void complexSteedK(const Complex& z, Complex& k0e, Complex& k1e);
+    static Complex complexRatioI1I0(const Complex& z);
+    static void complexAsymptoticI(const Complex& z, Complex& i0e, Complex& i1e);
+};
+
+#endif // BESSELFUNCTIONS_H
@@ -0,0 +1,113 @@
+/*
+ * besselfunctions_avx512.cpp
+ * 文件作用: 修正 Bessel 函数批量计算的 AVX-512 实现
+ * 功能描述:
+ * 1. 以 8 路双精度向量 (__m512d) 实现 besselkernels.h 所需的向量运算，并实例化通用算法。
+ * 2. 本文件以 AVX-512F 指令集编译 (见下方 target 预处理指令)，只在运行时检测到 CPU 支持时
+ *    由 BesselFunctions::dispatchBatch 调用。
+ * 3. 标准库头文件必须在 target 指令之前包含，避免内联函数以 AVX-512 指令生成后被其他翻译单元复用。
+ */
+
+#include "besselfunctions.h"
+
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BESSEL_HAS_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(BESSEL_HAS_X86) && !defined(BESSEL_NO_SIMD)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+#include "besselkernels.h"
+
+namespace {
+
+struct Avx512Ops
+{
+    using V = __m512d;
+    using M = __mmask8;
+    enum { Width = 8 };
+    static V set1(double v) { return _mm512_set1_pd(v); }
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V abs(V a) { return _mm512_abs_pd(a); }
+    static V min(V a, V b) { return _mm512_min_pd(a, b); }
+    static V max(V a, V b) { return _mm512_max_pd(a, b); }
+    static V sqrt(V a) { return _mm512_sqrt_pd(a); }
+    static V round(V a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static M le(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static M lt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static bool any(M m) { return m != 0; }
+    static bool all(M m) { return m == 0xFF; }
+    static V blend(M m, V ifTrue, V ifFalse) { return _mm512_mask_blend_pd(m, ifFalse, ifTrue); }
+
+    // 2^n (n 为 [-1022, 1023] 内的整数): 利用 2^52 + 1023 + n 的尾数位直接构造指数域
+    static V pow2(V n)
+    {
+        const __m512i bits = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(4503599627370496.0 + 1023.0)));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(bits, 52));
+    }
+    // 无偏指数 (x 为正规格化数)
+    static V exponent(V x)
+    {
+        const __m512i e = _mm512_srli_epi64(_mm512_castpd_si512(x), 52);
+        const __m512d biased = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(e, _mm512_set1_epi64(0x4330000000000000LL))),
+                                             _mm512_set1_pd(4503599627370496.0));
+        return _mm512_sub_pd(biased, _mm512_set1_pd(1023.0));
+    }
+    // 尾数 m ∈ [1, 2)
+    static V mantissa(V x)
+    {
+        const __m512i bits = _mm512_and_si512(_mm512_castpd_si512(x), _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL));
+        return _mm512_castsi512_pd(_mm512_or_si512(bits, _mm512_set1_epi64(0x3FF0000000000000LL)));
+    }
+    static V exp(V a) { return BesselKernels::simdExp<Avx512Ops>(a); }
+    static V log(V a) { return BesselKernels::simdLog<Avx512Ops>(a); }
+};
+
+enum BatchFunc { FuncK0 = 0, FuncK1, FuncI0e, FuncI1e };
+
+}
+
+void BesselFunctions::batchAvx512(int func, const double* x, double* out, int n)
+{
+    using namespace BesselKernels;
+    switch (func) {
+    case FuncK0:  batch<Avx512Ops>(x, out, n, k0<Avx512Ops>); break;
+    case FuncK1:  batch<Avx512Ops>(x, out, n, k1<Avx512Ops>); break;
+    case FuncI0e: batch<Avx512Ops>(x, out, n, i0e<Avx512Ops>); break;
+    case FuncI1e: batch<Avx512Ops>(x, out, n, i1e<Avx512Ops>); break;
+    default: break;
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+// 非 x86 平台: 退回标量实现 (detectSimdLevel 不会选择 AVX-512)
+void BesselFunctions::batchAvx512(int func, const double* x, double* out, int n)
+{
+    batchScalar(func, x, out, n);
+}
+
+#endif
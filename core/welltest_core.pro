@@ -0,0 +1,64 @@
+# ----------------------------------------------------
+# Project: welltest_core
+# Description: 试井计算核心静态库 (模型求解器、压力导数与平滑、Levenberg-Marquardt 拟合器、多起点与种群全局拟合)
+# 只依赖 QtCore 与 Eigen，不含任何界面代码；界面程序 WellTest、批处理程序与
+# benchmark/accuracy 工具通过 include(../welltest_core.pri) 链接该库
+# ----------------------------------------------------
+
+QT = core
+
+TEMPLATE = lib
+TARGET = welltest_core
+CONFIG += staticlib c++17
+
+# 库文件统一输出到构建根目录的 lib 子目录 (与 welltest_core.pri 一致)
+DESTDIR = $$shadowed($$PWD/..)/lib
+
+# 与主工程一致的优化选项
+QMAKE_CXXFLAGS += -O3
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+# [SIMD] MinGW 不保证 32/64 字节栈对齐，令汇编器把对齐向量访存改为非对齐访存 (见 WellTest.pro)
+win32-g++: QMAKE_CXXFLAGS += -Wa,-muse-unaligned-vector-move
+
+# Eigen 矩阵库 (拟合器法方程求解、CMA-ES 协方差分解)
+INCLUDEPATH += D:/08YYYXXX/eigen-3.3.8
+
+# 源文件位于主工程目录
+INCLUDEPATH += ..
+DEPENDPATH += ..
+
+HEADERS += \
+           ../besselfunctions.h \
+           ../besselkernels.h \
+           ../dualnumber.h \
+           ../evolutionaryfitter.h \
+           ../laplaceinversion.h \
+           ../levenbergmarquardtfitter.h \
+           ../modelsolver01-06.h \
+           ../multistartfitter.h \
+           ../pressurederivativecalculator.h \
+           ../pressurederivativecalculator1.h \
+           ../quadrature.h \
+           ../ratesuperposition.h \
+           ../solverthreadpool.h \
+           ../stehfestweights.h \
+           ../typecurvecache.h
+
+SOURCES += \
+           ../besselfunctions.cpp \
+           ../besselfunctions_avx2.cpp \
+           ../besselfunctions_avx512.cpp \
+           ../evolutionaryfitter.cpp \
+           ../laplaceinversion.cpp \
+           ../levenbergmarquardtfitter.cpp \
+           ../modelsolver01-06.cpp \
+           ../multistartfitter.cpp \
+           ../pressurederivativecalculator.cpp \
+           ../pressurederivativecalculator1.cpp \
+           ../quadrature.cpp \
+           ../ratesuperposition.cpp \
+           ../solverthreadpool.cpp \
+           ../stehfestweights.cpp \
+           ../typecurvecache.cpp
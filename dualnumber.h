@@ -0,0 +1,120 @@
+/*
+ * dualnumber.h
+ * 文件作用: 前向自动微分对偶数类型
+ * 功能描述:
+ * 1. Dual<N> 同时保存函数值 v 与对 N 个方向的一阶偏导数 d[0..N-1]，
+ *    四则运算与 sqrt / exp / log 按链式法则同步传播导数，一次计算即得到全部方向的精确导数。
+ * 2. 与 double、std::complex<double> 一起作为模型核函数的 Scalar 模板参数使用，
+ *    Bessel 函数的对偶数重载见 besselfunctions.h。
+ * 3. abs / real 返回函数值的实数量 (只用于阈值判断与误差估计)，比较运算只比较函数值，
+ *    因此对偶数计算与 double 计算的分支选择完全一致。
+ * 4. 导数个数 N 在编译期固定，全部数据位于栈上，运算中无堆内存分配。
+ */
+
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <cmath>
+#include <type_traits>
+
+template <int N>
+struct Dual
+{
+    static const int kDirections = N;
+
+    double v;       // 函数值
+    double d[N];    // 各方向偏导数
+
+    Dual() : v(0.0) { for (int i = 0; i < N; ++i) d[i] = 0.0; }
+    Dual(double value) : v(value) { for (int i = 0; i < N; ++i) d[i] = 0.0; }
+
+    // 自变量: 值为 value，第 direction 个方向的导数为 1
+    static Dual variable(double value, int direction) {
+        Dual x(value);
+        if (direction >= 0 && direction < N) x.d[direction] = 1.0;
+        return x;
+    }
+
+    Dual& operator+=(const Dual& b) { v += b.v; for (int i = 0; i < N; ++i) d[i] += b.d[i]; return *this; }
+    Dual& operator-=(const Dual& b) { v -= b.v; for (int i = 0; i < N; ++i) d[i] -= b.d[i]; return *this; }
+    Dual& operator*=(const Dual& b) {
+        for (int i = 0; i < N; ++i) d[i] = d[i] * b.v + v * b.d[i];
+        v *= b.v;
+        return *this;
+    }
+    Dual& operator/=(const Dual& b) {
+        // 函数值直接相除，与 double 运算逐位一致
+        const double inv = 1.0 / b.v;
+        v /= b.v;
+        for (int i = 0; i < N; ++i) d[i] = (d[i] - v * b.d[i]) * inv;
+        return *this;
+    }
+    Dual& operator+=(double b) { v += b; return *this; }
+    Dual& operator-=(double b) { v -= b; return *this; }
+    Dual& operator*=(double b) { v *= b; for (int i = 0; i < N; ++i) d[i] *= b; return *this; }
+    Dual& operator/=(double b) { v /= b; for (int i = 0; i < N; ++i) d[i] /= b; return *this; }
+};
+
+// 类型萃取: 是否为对偶数
+template <typename T> struct IsDual : std::false_type {};
+template <int N> struct IsDual<Dual<N>> : std::true_type {};
+
+// ---------------- 四则运算 ----------------
+template <int N> inline Dual<N> operator-(const Dual<N>& a) { Dual<N> r; r.v = -a.v; for (int i = 0; i < N; ++i) r.d[i] = -a.d[i]; return r; }
+template <int N> inline Dual<N> operator+(Dual<N> a, const Dual<N>& b) { return a += b; }
+template <int N> inline Dual<N> operator-(Dual<N> a, const Dual<N>& b) { return a -= b; }
+template <int N> inline Dual<N> operator*(Dual<N> a, const Dual<N>& b) { return a *= b; }
+template <int N> inline Dual<N> operator/(Dual<N> a, const Dual<N>& b) { return a /= b; }
+template <int N> inline Dual<N> operator+(Dual<N> a, double b) { return a += b; }
+template <int N> inline Dual<N> operator-(Dual<N> a, double b) { return a -= b; }
+template <int N> inline Dual<N> operator*(Dual<N> a, double b) { return a *= b; }
+template <int N> inline Dual<N> operator/(Dual<N> a, double b) { return a /= b; }
+template <int N> inline Dual<N> operator+(double a, Dual<N> b) { return b += a; }
+template <int N> inline Dual<N> operator-(double a, const Dual<N>& b) { Dual<N> r = -b; r.v += a; return r; }
+template <int N> inline Dual<N> operator*(double a, Dual<N> b) { return b *= a; }
+template <int N> inline Dual<N> operator/(double a, const Dual<N>& b) {
+    Dual<N> r;
+    r.v = a / b.v;
+    const double f = -r.v / b.v;
+    for (int i = 0; i < N; ++i) r.d[i] = f * b.d[i];
+    return r;
+}
+
+// ---------------- 比较 (只比较函数值) ----------------
+template <int N> inline bool operator<(const Dual<N>& a, double b) { return a.v < b; }
+template <int N> inline bool operator>(const Dual<N>& a, double b) { return a.v > b; }
+template <int N> inline bool operator<=(const Dual<N>& a, double b) { return a.v <= b; }
+template <int N> inline bool operator>=(const Dual<N>& a, double b) { return a.v >= b; }
+
+// ---------------- 初等函数 ----------------
+// 一元函数 f 的对偶扩展: 值 fv，导数 dfv·a.d
+template <int N> inline Dual<N> dualApply(const Dual<N>& a, double fv, double dfv)
+{
+    Dual<N> r;
+    r.v = fv;
+    for (int i = 0; i < N; ++i) r.d[i] = dfv * a.d[i];
+    return r;
+}
+
+template <int N> inline Dual<N> sqrt(const Dual<N>& a) { const double s = std::sqrt(a.v); return dualApply(a, s, 0.5 / s); }
+template <int N> inline Dual<N> exp(const Dual<N>& a) { const double e = std::exp(a.v); return dualApply(a, e, e); }
+template <int N> inline Dual<N> log(const Dual<N>& a) { return dualApply(a, std::log(a.v), 1.0 / a.v); }
+
+// 函数值的绝对值与实部 (阈值判断、误差估计用)
+template <int N> inline double abs(const Dual<N>& a) { return std::abs(a.v); }
+template <int N> inline double real(const Dual<N>& a) { return a.v; }
+
+template <int N> inline bool isFiniteDual(const Dual<N>& a)
+{
+    if (!std::isfinite(a.v)) return false;
+    for (int i = 0; i < N; ++i) {
+        if (!std::isfinite(a.d[i])) return false;
+    }
+    return true;
+}
+
+// 取函数值 (double 与复数原样返回)
+inline double dualValue(double a) { return a; }
+template <int N> inline double dualValue(const Dual<N>& a) { return a.v; }
+
+#endif // DUALNUMBER_H
@@ -0,0 +1,361 @@
+/*
+ * evolutionaryfitter.cpp
+ * 文件作用: 基于种群的全局拟合器实现 (属于 welltest_core 库)
+ * 功能描述:
+ * 1. 差分进化: 拉丁超立方初始种群 (含参数表当前值)，DE/rand/1/bin 变异交叉，越界分量取与父代的中点，一对一贪婪选择。
+ * 2. CMA-ES: 以参数表当前值为初始均值，加权重组、累积步长控制 (CSA)、秩一与秩 mu 协方差更新，越界样本截断到边界。
+ * 3. 每代一次批量调用求解器计算全部个体曲线 (求解器内部按参数组与时间点并行)。
+ * 4. 精修阶段复用 LevenbergMarquardtFitter，回调与停止请求原样转发，模型计算次数合并统计。
+ */
+
+#include "evolutionaryfitter.h"
+#include "multistartfitter.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+EvolutionaryFitter::EvolutionaryFitter(ModelSolver01_06* solver)
+    : m_solver(solver)
+    , m_weight(0.5)
+{
+}
+
+void EvolutionaryFitter::setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative)
+{
+    m_obsTime = t;
+    m_obsDeltaP = deltaP;
+    m_obsDerivative = derivative;
+}
+
+void EvolutionaryFitter::setWeight(double weight)
+{
+    m_weight = weight;
+}
+
+void EvolutionaryFitter::setOptions(const Options& options)
+{
+    m_options = options;
+}
+
+void EvolutionaryFitter::setRateSchedule(const RateSuperposition& rates)
+{
+    m_rates = rates;
+}
+
+void EvolutionaryFitter::setIterationCallback(const IterationCallback& callback)
+{
+    m_iterationCallback = callback;
+}
+
+void EvolutionaryFitter::setProgressCallback(const ProgressCallback& callback)
+{
+    m_progressCallback = callback;
+}
+
+void EvolutionaryFitter::setStopPredicate(const StopPredicate& predicate)
+{
+    m_stopPredicate = predicate;
+}
+
+QMap<QString, double> EvolutionaryFitter::decode(const QMap<QString, double>& base, const QVector<Dimension>& dims, const QVector<double>& x) const
+{
+    QMap<QString, double> params = base;
+    for(int i = 0; i < dims.size(); ++i) {
+        double v = dims[i].lo + (dims[i].hi - dims[i].lo) * qBound(0.0, x[i], 1.0);
+        params[dims[i].name] = dims[i].logScale ? pow(10.0, v) : v;
+    }
+    LevenbergMarquardtFitter::updateDerivedParameters(params);
+    return params;
+}
+
+QVector<double> EvolutionaryFitter::encode(const QMap<QString, double>& params, const QVector<Dimension>& dims) const
+{
+    QVector<double> x(dims.size());
+    for(int i = 0; i < dims.size(); ++i) {
+        double v = params.value(dims[i].name);
+        if(dims[i].logScale) v = v > 0.0 ? log10(v) : dims[i].lo;
+        x[i] = qBound(0.0, (v - dims[i].lo) / (dims[i].hi - dims[i].lo), 1.0);
+    }
+    return x;
+}
+
+QVector<double> EvolutionaryFitter::evaluate(const LevenbergMarquardtFitter& objective, const QMap<QString, double>& base,
+                                             const QVector<Dimension>& dims, const QVector<QVector<double>>& xs,
+                                             const SolverConfig& config) const
+{
+    QVector<QMap<QString, double>> paramSets;
+    paramSets.reserve(xs.size());
+    for(const QVector<double>& x : xs) paramSets.append(decode(base, dims, x));
+
+    QVector<ModelCurveData> curves = objective.calculateCurves(paramSets, m_obsTime, config);
+
+    QVector<double> mse(xs.size(), std::numeric_limits<double>::infinity());
+    for(int k = 0; k < curves.size() && k < mse.size(); ++k) {
+        // 残差对非正的计算值取 0，全局搜索中需排除压差曲线无效的个体，否则退化曲线会得到虚假的零误差
+        const QVector<double>& pCal = std::get<1>(curves[k]);
+        bool valid = pCal.size() >= m_obsDeltaP.size();
+        for(int i = 0; valid && i < m_obsDeltaP.size(); ++i) {
+            if(m_obsDeltaP[i] > 1e-10 && !(pCal[i] > 1e-10 && std::isfinite(pCal[i]))) valid = false;
+        }
+        if(!valid) continue;
+
+        QVector<double> r = objective.calculateResiduals(curves[k]);
+        if(r.isEmpty()) continue;
+        double sse = LevenbergMarquardtFitter::calculateSumSquaredError(r);
+        if(std::isfinite(sse)) mse[k] = sse / r.size();
+    }
+    return mse;
+}
+
+EvolutionaryFitter::Result EvolutionaryFitter::fit(const QList<FitParameter>& params, const SolverConfig& config) const
+{
+    Result result;
+    for(const auto& p : params) result.params.insert(p.name, p.value);
+    LevenbergMarquardtFitter::updateDerivedParameters(result.params);
+    if(!m_solver || m_obsTime.isEmpty()) return result;
+
+    const SolverConfig finalConfig = config.withHighPrecision(true);
+
+    QVector<Dimension> dims;
+    for(const FitParameter& p : params) {
+        if(!p.isFit || p.name == "LfD" || !(p.max > p.min)) continue;
+        Dimension d;
+        d.name = p.name;
+        d.logScale = MultiStartFitter::isLogSampled(p);
+        d.lo = d.logScale ? log10(p.min) : p.min;
+        d.hi = d.logScale ? log10(p.max) : p.max;
+        dims.append(d);
+    }
+    const int n = dims.size();
+    if(n == 0) return result;
+
+    // 与 LM 相同的迭代配置 (快速模式，只在全部拟合参数为换算参数时使用典型曲线缓存)
+    QStringList names;
+    for(const Dimension& d : dims) names.append(d.name);
+    const SolverConfig fitConfig = LevenbergMarquardtFitter::fittingConfig(config, names);
+
+    LevenbergMarquardtFitter objective(m_solver);
+    objective.setObservedData(m_obsTime, m_obsDeltaP, m_obsDerivative);
+    objective.setWeight(m_weight);
+    objective.setRateSchedule(m_rates);
+
+    const QMap<QString, double> base = result.params;
+    const bool polish = m_options.polishWithLevenbergMarquardt;
+    const int globalShare = polish ? 70 : 100;    // 全局搜索阶段占进度条的比例
+
+    std::mt19937 rng(m_options.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    Member best;
+    best.x = encode(base, dims);
+    best.mse = std::numeric_limits<double>::infinity();
+    LevenbergMarquardtFitter::EvaluationStats& stats = result.stats;
+
+    // 整代计算并更新全局最优个体，最优改进时输出一次当前曲线
+    auto evaluateGeneration = [&](const QVector<QVector<double>>& xs) {
+        QVector<double> mse = evaluate(objective, base, dims, xs, fitConfig);
+        stats.residualEvaluations += xs.size();
+        bool improved = false;
+        for(int k = 0; k < xs.size(); ++k) {
+            if(mse[k] < best.mse) {
+                best.x = xs[k];
+                best.mse = mse[k];
+                improved = true;
+            }
+        }
+        if(improved && m_iterationCallback) {
+            QMap<QString, double> p = decode(base, dims, best.x);
+            m_iterationCallback(best.mse, p, objective.calculateCurve(p, QVector<double>(), fitConfig));
+        }
+        return mse;
+    };
+    auto finished = [&](int generation) {
+        result.generations = generation;
+        if(m_progressCallback) m_progressCallback(generation * globalShare / qMax(1, m_options.maxGenerations), stats);
+        if(m_stopPredicate && m_stopPredicate()) {
+            result.stopped = true;
+            return true;
+        }
+        return best.mse < m_options.targetMse;
+    };
+
+    if(m_options.method == DifferentialEvolution) {
+        const int np = m_options.populationSize > 0 ? qMax(4, m_options.populationSize) : qBound(15, 10 * n, 60);
+
+        // 初始种群: 参数表当前值 + 拉丁超立方样本
+        QVector<QVector<double>> pop(np, QVector<double>(n));
+        pop[0] = best.x;
+        std::vector<int> strata(np - 1);
+        for(int i = 0; i < n; ++i) {
+            std::iota(strata.begin(), strata.end(), 0);
+            std::shuffle(strata.begin(), strata.end(), rng);
+            for(int k = 1; k < np; ++k) pop[k][i] = (strata[k - 1] + unit(rng)) / (np - 1);
+        }
+        QVector<double> fitness = evaluateGeneration(pop);
+
+        std::uniform_int_distribution<int> pick(0, np - 1);
+        std::uniform_int_distribution<int> pickDim(0, n - 1);
+        for(int gen = 1; gen <= m_options.maxGenerations; ++gen) {
+            if(finished(gen - 1)) break;
+
+            QVector<QVector<double>> trials(np, QVector<double>(n));
+            for(int k = 0; k < np; ++k) {
+                int r1, r2, r3;
+                do { r1 = pick(rng); } while(r1 == k);
+                do { r2 = pick(rng); } while(r2 == k || r2 == r1);
+                do { r3 = pick(rng); } while(r3 == k || r3 == r1 || r3 == r2);
+                const int jrand = pickDim(rng);
+                for(int i = 0; i < n; ++i) {
+                    if(i == jrand || unit(rng) < m_options.crossoverRate) {
+                        double v = pop[r1][i] + m_options.differentialWeight * (pop[r2][i] - pop[r3][i]);
+                        if(v < 0.0) v = 0.5 * pop[k][i];
+                        else if(v > 1.0) v = 0.5 * (pop[k][i] + 1.0);
+                        trials[k][i] = v;
+                    } else {
+                        trials[k][i] = pop[k][i];
+                    }
+                }
+            }
+
+            QVector<double> trialFitness = evaluateGeneration(trials);
+            for(int k = 0; k < np; ++k) {
+                if(trialFitness[k] <= fitness[k]) {
+                    pop[k] = trials[k];
+                    fitness[k] = trialFitness[k];
+                }
+            }
+            result.generations = gen;
+        }
+    } else {
+        const int lambda = m_options.populationSize > 0 ? qMax(4, m_options.populationSize)
+                                                        : qMax(8, 4 + int(3.0 * std::log(double(n))));
+        const int mu = lambda / 2;
+
+        // 重组权重与策略参数 (Hansen 推荐的默认值)
+        Eigen::VectorXd weights(mu);
+        for(int i = 0; i < mu; ++i) weights[i] = std::log(mu + 0.5) - std::log(i + 1.0);
+        weights /= weights.sum();
+        const double mueff = 1.0 / weights.squaredNorm();
+        const double cc = (4.0 + mueff / n) / (n + 4.0 + 2.0 * mueff / n);
+        const double cs = (mueff + 2.0) / (n + mueff + 5.0);
+        const double c1 = 2.0 / ((n + 1.3) * (n + 1.3) + mueff);
+        const double cmu = qMin(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((n + 2.0) * (n + 2.0) + mueff));
+        const double damps = 1.0 + 2.0 * qMax(0.0, std::sqrt((mueff - 1.0) / (n + 1.0)) - 1.0) + cs;
+        const double chiN = std::sqrt(double(n)) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+        Eigen::VectorXd mean = Eigen::Map<const Eigen::VectorXd>(best.x.constData(), n);
+        double sigma = m_options.initialSigma;
+        Eigen::MatrixXd C = Eigen::MatrixXd::Identity(n, n);
+        Eigen::MatrixXd B = Eigen::MatrixXd::Identity(n, n);
+        Eigen::VectorXd D = Eigen::VectorXd::Ones(n);
+        Eigen::VectorXd pc = Eigen::VectorXd::Zero(n);
+        Eigen::VectorXd ps = Eigen::VectorXd::Zero(n);
+        std::normal_distribution<double> normal(0.0, 1.0);
+
+        // 初始均值本身也参与评价，保证结果不劣于参数表当前值
+        evaluateGeneration(QVector<QVector<double>>{best.x});
+
+        for(int gen = 1; gen <= m_options.maxGenerations; ++gen) {
+            if(finished(gen - 1)) break;
+
+            // 采样: x = m + sigma·B·D·z，越界分量截断到边界
+            QVector<QVector<double>> xs(lambda, QVector<double>(n));
+            for(int k = 0; k < lambda; ++k) {
+                Eigen::VectorXd z(n);
+                for(int i = 0; i < n; ++i) z[i] = normal(rng);
+                Eigen::VectorXd x = mean + sigma * (B * D.cwiseProduct(z));
+                for(int i = 0; i < n; ++i) xs[k][i] = qBound(0.0, x[i], 1.0);
+            }
+            QVector<double> fitness = evaluateGeneration(xs);
+
+            QVector<int> order(lambda);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&fitness](int a, int b) { return fitness[a] < fitness[b]; });
+
+            const Eigen::VectorXd oldMean = mean;
+            mean.setZero();
+            for(int i = 0; i < mu; ++i) mean += weights[i] * Eigen::Map<const Eigen::VectorXd>(xs[order[i]].constData(), n);
+            const Eigen::VectorXd yw = (mean - oldMean) / sigma;
+
+            // 步长路径与协方差路径
+            const Eigen::VectorXd invSqrtCy = B * (B.transpose() * yw).cwiseQuotient(D);
+            ps = (1.0 - cs) * ps + std::sqrt(cs * (2.0 - cs) * mueff) * invSqrtCy;
+            const double psNorm = ps.norm();
+            const bool hsig = psNorm / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * gen)) / chiN < 1.4 + 2.0 / (n + 1.0);
+            pc = (1.0 - cc) * pc + (hsig ? std::sqrt(cc * (2.0 - cc) * mueff) : 0.0) * yw;
+
+            Eigen::MatrixXd rankMu = Eigen::MatrixXd::Zero(n, n);
+            for(int i = 0; i < mu; ++i) {
+                Eigen::VectorXd y = (Eigen::Map<const Eigen::VectorXd>(xs[order[i]].constData(), n) - oldMean) / sigma;
+                rankMu += weights[i] * y * y.transpose();
+            }
+            C = (1.0 - c1 - cmu) * C
+                + c1 * (pc * pc.transpose() + (hsig ? 0.0 : cc * (2.0 - cc)) * C)
+                + cmu * rankMu;
+            sigma *= std::exp((cs / damps) * (psNorm / chiN - 1.0));
+
+            Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(0.5 * (C + C.transpose()));
+            B = eig.eigenvectors();
+            D = eig.eigenvalues().cwiseMax(1e-20).cwiseSqrt();
+            result.generations = gen;
+
+            // 分布已收缩到数值精度以下，继续迭代没有意义
+            if(sigma * D.maxCoeff() < 1e-8) break;
+        }
+    }
+
+    // 无论因收敛、停止请求还是达到最大代数结束，全局搜索阶段的进度都应到达其份额 (末代不经过 finished)
+    if(m_progressCallback) m_progressCallback(globalShare, stats);
+
+    result.params = decode(base, dims, best.x);
+    result.globalMse = best.mse;
+    result.mse = best.mse;
+
+    if(polish && !result.stopped) {
+        // LM 精修: 统计在全局搜索基础上累加，进度映射到剩余区间
+        QList<FitParameter> start = params;
+        for(FitParameter& p : start) p.value = result.params.value(p.name, p.value);
+
+        const LevenbergMarquardtFitter::EvaluationStats globalStats = stats;
+        LevenbergMarquardtFitter lm(m_solver);
+        lm.setObservedData(m_obsTime, m_obsDeltaP, m_obsDerivative);
+        lm.setWeight(m_weight);
+        lm.setOptions(m_options.lmOptions);
+        lm.setRateSchedule(m_rates);
+        lm.setIterationCallback(m_iterationCallback);
+        lm.setStopPredicate(m_stopPredicate);
+        if(m_progressCallback) {
+            lm.setProgressCallback([this, globalShare, globalStats](int percent, const LevenbergMarquardtFitter::EvaluationStats& s) {
+                LevenbergMarquardtFitter::EvaluationStats total = globalStats;
+                total.residualEvaluations += s.residualEvaluations;
+                total.jacobianEvaluations += s.jacobianEvaluations;
+                total.jacobianModelEvaluations += s.jacobianModelEvaluations;
+                total.broydenUpdates += s.broydenUpdates;
+                m_progressCallback(globalShare + percent * (100 - globalShare) / 100, total);
+            });
+        }
+
+        LevenbergMarquardtFitter::Result polished = lm.fit(start, config);
+        stats.residualEvaluations += polished.stats.residualEvaluations;
+        stats.jacobianEvaluations += polished.stats.jacobianEvaluations;
+        stats.jacobianModelEvaluations += polished.stats.jacobianModelEvaluations;
+        stats.broydenUpdates += polished.stats.broydenUpdates;
+        result.stopped = polished.stopped;
+        result.polished = true;
+        if(polished.mse <= best.mse || !std::isfinite(best.mse)) {
+            result.params = polished.params;
+            result.mse = polished.mse;
+            result.curve = polished.curve;
+            return result;
+        }
+    }
+
+    result.curve = objective.calculateCurve(result.params, QVector<double>(), finalConfig);
+    if(m_progressCallback) m_progressCallback(100, stats);
+    if(m_iterationCallback) m_iterationCallback(result.mse, result.params, result.curve);
+    return result;
+}
@@ -0,0 +1,106 @@
+/*
+ * evolutionaryfitter.h
+ * 文件作用: 基于种群的全局拟合器头文件 (差分进化 DE / CMA-ES，属于 welltest_core 库，不依赖界面)
+ * 功能描述:
+ * 1. 无需导数的全局搜索，适用于双重孔隙参数 (omega、lambda) 等约束较弱、LM 易陷入局部极小的情形。
+ * 2. 在归一化坐标 [0,1]^n 中搜索: 每个拟合参数映射到其上下限，对数参数在 log10 空间线性映射。
+ * 3. 每一代的整个种群通过 ModelSolver01_06::calculateTheoreticalCurves 批量并行计算，目标函数与 LM 相同
+ *    (设置了变产量史时经由 LevenbergMarquardtFitter::calculateCurves 逐个叠加计算)。
+ * 4. 最优个体改进时通过迭代回调输出；结束后可把最优个体交给 LevenbergMarquardtFitter 精修。
+ */
+
+#ifndef EVOLUTIONARYFITTER_H
+#define EVOLUTIONARYFITTER_H
+
+#include "levenbergmarquardtfitter.h"
+
+class EvolutionaryFitter
+{
+public:
+    enum Method {
+        DifferentialEvolution,  // DE/rand/1/bin
+        CmaEs                   // (mu/mu_w, lambda)-CMA-ES
+    };
+
+    struct Options {
+        Method method = DifferentialEvolution;
+        int populationSize = 0;             // 种群规模，0 时自动选择 (DE: 10n 限制在 [15, 60]；CMA-ES: 4 + 3ln(n)，至少 8)
+        int maxGenerations = 60;            // 最大代数
+        double targetMse = 3e-3;            // 最优个体平均残差平方低于该值时提前结束
+        unsigned int seed = 20240601;       // 随机种子 (固定种子使结果可复现)
+
+        double differentialWeight = 0.7;    // DE 差分缩放因子 F
+        double crossoverRate = 0.9;         // DE 交叉概率 CR
+        double initialSigma = 0.3;          // CMA-ES 初始步长 (归一化坐标)
+
+        bool polishWithLevenbergMarquardt = true;       // 结束后以最优个体为起点运行 LM 精修
+        LevenbergMarquardtFitter::Options lmOptions;    // 精修所用 LM 选项
+    };
+
+    struct Result {
+        QMap<QString, double> params;   // 最终参数 (含派生参数 LfD)
+        double mse = 0.0;               // 平均残差平方 (快速模式)
+        double globalMse = 0.0;         // 全局搜索阶段结束时最优个体的平均残差平方
+        int generations = 0;            // 完成的代数
+        bool polished = false;          // 是否经过 LM 精修
+        bool stopped = false;           // 是否因停止请求提前结束
+        LevenbergMarquardtFitter::EvaluationStats stats;    // 模型计算次数 (全局搜索计入残差计算次数，含精修)
+        ModelCurveData curve;           // 高精度计算的最终理论曲线 (求解器默认时间网格)
+    };
+
+    using IterationCallback = LevenbergMarquardtFitter::IterationCallback;
+    using ProgressCallback = LevenbergMarquardtFitter::ProgressCallback;
+    using StopPredicate = LevenbergMarquardtFitter::StopPredicate;
+
+    explicit EvolutionaryFitter(ModelSolver01_06* solver);
+
+    void setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative);
+    void setWeight(double weight);
+    void setOptions(const Options& options);
+    // 变产量史 (为空时按恒定产量计算)
+    void setRateSchedule(const RateSuperposition& rates);
+
+    void setIterationCallback(const IterationCallback& callback);
+    void setProgressCallback(const ProgressCallback& callback);
+    void setStopPredicate(const StopPredicate& predicate);
+
+    // 执行全局拟合 (config 按次传入，搜索使用快速模式，最终曲线使用高精度)
+    Result fit(const QList<FitParameter>& params, const SolverConfig& config) const;
+
+private:
+    // 拟合参数在归一化坐标中的映射信息
+    struct Dimension {
+        QString name;
+        double lo;          // 下限 (对数参数为 log10)
+        double hi;          // 上限 (对数参数为 log10)
+        bool logScale;
+    };
+
+    // 单个个体: 归一化坐标与平均残差平方
+    struct Member {
+        QVector<double> x;
+        double mse;
+    };
+
+    QMap<QString, double> decode(const QMap<QString, double>& base, const QVector<Dimension>& dims, const QVector<double>& x) const;
+    QVector<double> encode(const QMap<QString, double>& params, const QVector<Dimension>& dims) const;
+
+    // 整代批量计算: 返回各个体的平均残差平方 (压差曲线无效的个体记为无穷大)
+    QVector<double> evaluate(const LevenbergMarquardtFitter& objective, const QMap<QString, double>& base,
+                             const QVector<Dimension>& dims, const QVector<QVector<double>>& xs,
+                             const SolverConfig& config) const;
+
+    ModelSolver01_06* m_solver;
+    QVector<double> m_obsTime;
+    QVector<double> m_obsDeltaP;
+    QVector<double> m_obsDerivative;
+    double m_weight;
+    Options m_options;
+    RateSuperposition m_rates;
+
+    IterationCallback m_iterationCallback;
+    ProgressCallback m_progressCallback;
+    StopPredicate m_stopPredicate;
+};
+
+#endif // EVOLUTIONARYFITTER_H
@@ -6,6 +6,7 @@
  * 2. 实现智能列名识别，自动匹配 Time, Pressure 等列。
  * 3. 实现试井类型切换逻辑：降落试井需输入地层压力，恢复试井自动计算。
  * 4. [修改] 适配多文件数据源，实现项目文件切换与预览联动。
+ * 5. 可选产量列: 选中时拟合界面按变产量叠加计算理论曲线。
  */
 
 #include "fittingdatadialog.h"
@@ -187,6 +188,7 @@ void FittingDataDialog::updateColumnComboBoxes(const QStringList& headers)
     ui->comboTime->clear();
     ui->comboPressure->clear();
     ui->comboDerivative->clear();
+    ui->comboRate->clear();
 
     // 添加选项
     ui->comboTime->addItems(headers);
@@ -198,6 +200,12 @@ void FittingDataDialog::updateColumnComboBoxes(const QStringList& headers)
         ui->comboDerivative->addItem(headers[i], i); // UserData 对应列索引
     }
 
+    // 产量列同样可选，第一项为恒定产量 (使用模型参数 q)
+    ui->comboRate->addItem("无 (恒定产量)", -1);
+    for(int i=0; i<headers.size(); ++i) {
+        ui->comboRate->addItem(headers[i], i);
+    }
+
     // 智能匹配列名
     for (int i = 0; i < headers.size(); ++i) {
         QString h = headers[i].toLower();
@@ -211,6 +219,9 @@ void FittingDataDialog::updateColumnComboBoxes(const QStringList& headers)
             // 注意 comboDerivative 第0项是自动计算，所以索引要+1
             ui->comboDerivative->setCurrentIndex(i + 1);
         }
+        if (h.contains("rate") || h.contains("产量")) {
+            ui->comboRate->setCurrentIndex(i + 1);
+        }
     }
 }
 
@@ -371,6 +382,7 @@ FittingDataSettings FittingDataDialog::getSettings() const
 
     // 获取导数列：itemData存储了真实的列索引，-1表示自动
     s.derivColIndex = ui->comboDerivative->currentData().toInt();
+    s.rateColIndex = ui->comboRate->currentData().toInt();
 
     s.skipRows = ui->spinSkipRows->value();
 
@@ -2,7 +2,7 @@
  * 文件名: fittingparameterchart.h
  * 文件作用: 拟合参数图表管理类头文件
  * 功能描述:
- * 1. 定义拟合参数结构体 FitParameter。
+ * 1. 拟合参数结构体 FitParameter 定义在 levenbergmarquardtfitter.h (与拟合器共用)。
  * 2. 管理拟合界面参数表格的显示、交互与逻辑。
  * 3. 实现参数的默认选择逻辑：根据试井模型类型，自动勾选需要拟合的核心参数。
  * 4. 实现鼠标滚轮调节参数功能，并增加防抖动和边界限制保护。
@@ -18,18 +18,7 @@
 #include <QEvent>
 #include <QTimer>
 #include "modelmanager.h"
-
-// 定义拟合参数结构体
-struct FitParameter {
-    QString name;           // 参数内部标识 (如 "kf")
-    QString displayName;    // 参数显示名称 (如 "内区渗透率")
-    double value = 0.0;     // 当前值
-    bool isFit = false;     // 是否参与拟合
-    double min = 0.0;       // 最小值限制
-    double max = 100.0;     // 最大值限制
-    bool isVisible = true;  // 是否在表格中显示
-    double step = 0.1;      // 滚轮调节步长
-};
+#include "levenbergmarquardtfitter.h" // FitParameter 结构体定义
 
 class FittingParameterChart : public QObject
 {
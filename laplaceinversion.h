@@ -0,0 +1,126 @@
+/*
+ * laplaceinversion.h
+ * 文件作用: 拉普拉斯数值反演算法接口头文件
+ * 功能描述:
+ * 1. 定义可插拔的数值反演策略接口 LaplaceInversion，求解器通过该接口完成 p̄(s) -> p(t) 的反演。
+ * 2. 反演分两步进行：先给出所需的全部拉普拉斯节点 s_j (laplaceNodes)，
+ *    由调用方计算像函数值 F(s_j) 后再组合出时域结果 (invert)，便于批量/并行计算核函数。
+ * 3. 提供四种实现：
+ *    - Stehfest           : 实数节点，每个时间点 N 次核函数计算；
+ *    - 固定 Talbot        : 复数节点 (Abate-Valkó)，每个时间点 M 次计算；
+ *    - de Hoog-Knight-Stokes : 复数节点，同一对数周期内的时间点共享 2M+1 个节点；
+ *    - Euler (Abate-Whitt): 复数节点，每个时间点 2M+1 次计算。
+ * 4. 每种方法均可报告平均每个时间点的拉普拉斯函数计算次数。
+ */
+
+#ifndef LAPLACEINVERSION_H
+#define LAPLACEINVERSION_H
+
+#include <QString>
+#include <QVector>
+#include <complex>
+#include <memory>
+
+class LaplaceInversion
+{
+public:
+    using Complex = std::complex<double>;
+
+    // 反演方法枚举
+    enum Method {
+        Stehfest = 0,   // Gaver-Stehfest 方法
+        Talbot,         // 固定 Talbot 方法
+        DeHoog,         // de Hoog-Knight-Stokes 方法
+        Euler           // Euler (Abate-Whitt) 方法
+    };
+
+    explicit LaplaceInversion(int order);
+    virtual ~LaplaceInversion();
+
+    // 方法类型与名称
+    virtual Method method() const = 0;
+    QString name() const { return methodName(method()); }
+
+    // 反演阶数 (Stehfest 为 N，其余方法为 M)
+    int order() const { return m_order; }
+
+    // 节点是否全部为实数 (实数节点可使用更快的实数核函数)
+    virtual bool realNodes() const { return false; }
+
+    // 第一步：给出反演时间序列 t (均须为正) 所需的全部拉普拉斯节点
+    virtual void laplaceNodes(const QVector<double>& t, QVector<Complex>& nodes) const = 0;
+
+    // 第二步：由节点处的像函数值 values[j] = F(nodes[j]) 组合出 f(t)
+    virtual void invert(const QVector<double>& t, const QVector<Complex>& values, QVector<double>& f) const = 0;
+
+    // 反演给定时间序列时，平均每个时间点的拉普拉斯函数计算次数
+    double evaluationsPerPoint(const QVector<double>& t) const;
+
+    // 工厂函数：order <= 0 时使用该方法的默认阶数
+    static std::unique_ptr<LaplaceInversion> create(Method method, int order = 0);
+
+    // 各方法的默认阶数 (高精度 / 快速模式)
+    static int defaultOrder(Method method, bool highPrecision);
+
+    // 方法显示名称
+    static QString methodName(Method method);
+
+protected:
+    int m_order;
+};
+
+// Gaver-Stehfest 方法：f(t) = ln2/t Σ V_m F(m ln2/t)
+class StehfestInversion : public LaplaceInversion
+{
+public:
+    explicit StehfestInversion(int N);
+    Method method() const override { return Stehfest; }
+    bool realNodes() const override { return true; }
+    void laplaceNodes(const QVector<double>& t, QVector<Complex>& nodes) const override;
+    void invert(const QVector<double>& t, const QVector<Complex>& values, QVector<double>& f) const override;
+};
+
+// 固定 Talbot 方法 (Abate & Valkó 2004)：积分路径 s(θ) = rθ(cotθ + i), r = 2M/(5t)
+class TalbotInversion : public LaplaceInversion
+{
+public:
+    explicit TalbotInversion(int M);
+    Method method() const override { return Talbot; }
+    void laplaceNodes(const QVector<double>& t, QVector<Complex>& nodes) const override;
+    void invert(const QVector<double>& t, const QVector<Complex>& values, QVector<double>& f) const override;
+};
+
+// de Hoog-Knight-Stokes 方法 (1982)：Fourier 级数 + QD 算法构造的连分式加速
+// 时间点按对数周期分组，同一组共享一套 2M+1 个节点 s_k = γ + iπk/T
+class DeHoogInversion : public LaplaceInversion
+{
+public:
+    explicit DeHoogInversion(int M);
+    Method method() const override { return DeHoog; }
+    void laplaceNodes(const QVector<double>& t, QVector<Complex>& nodes) const override;
+    void invert(const QVector<double>& t, const QVector<Complex>& values, QVector<double>& f) const override;
+
+private:
+    // 时间窗口：窗口内时间点下标及其半周期 T
+    struct Window {
+        QVector<int> indices;
+        double T = 0.0;
+    };
+    QVector<Window> buildWindows(const QVector<double>& t) const;
+    double dampingGamma(double T) const;
+};
+
+// Euler 方法 (Abate & Whitt 2006)：Bromwich 积分梯形离散 + 二项式 Euler 求和加速
+class EulerInversion : public LaplaceInversion
+{
+public:
+    explicit EulerInversion(int M);
+    Method method() const override { return Euler; }
+    void laplaceNodes(const QVector<double>& t, QVector<Complex>& nodes) const override;
+    void invert(const QVector<double>& t, const QVector<Complex>& values, QVector<double>& f) const override;
+
+private:
+    QVector<double> m_xi;   // Euler 求和权重 ξ_k (k = 0..2M)
+};
+
+#endif // LAPLACEINVERSION_H
@@ -0,0 +1,464 @@
+/*
+ * levenbergmarquardtfitter.cpp
+ * 文件作用: Levenberg-Marquardt 非线性回归拟合器实现 (属于 welltest_core 库)
+ * 功能描述:
+ * 1. 阻尼最小二乘迭代: 法方程 (JᵀJ + λ·diag) δ = -Jᵀr，步长被接受时减小阻尼，否则增大阻尼重试。
+ * 2. 正值参数 (表皮系数、裂缝条数除外) 在 log10 空间更新，更新后限制在参数上下限内。
+ * 3. 雅可比矩阵优先由模型核函数的前向自动微分精确计算，反演方法不支持时退回中心差分。
+ * 4. Broyden 模式: 接受步长后按残差变化做秩一更新，近似矩阵下步长被拒绝、增益比过低或
+ *    连续更新达到上限时完整重算，并统计各部分的模型计算次数。
+ * 5. 设置变产量史时，全部理论曲线经由 RateSuperposition 叠加计算 (calculateCurve/calculateCurves)。
+ */
+
+#include "levenbergmarquardtfitter.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+
+LevenbergMarquardtFitter::LevenbergMarquardtFitter(ModelSolver01_06* solver)
+    : m_solver(solver)
+    , m_weight(0.5)
+{
+}
+
+void LevenbergMarquardtFitter::setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative)
+{
+    m_obsTime = t;
+    m_obsDeltaP = deltaP;
+    m_obsDerivative = derivative;
+}
+
+void LevenbergMarquardtFitter::setWeight(double weight)
+{
+    m_weight = weight;
+}
+
+void LevenbergMarquardtFitter::setOptions(const Options& options)
+{
+    m_options = options;
+}
+
+void LevenbergMarquardtFitter::setRateSchedule(const RateSuperposition& rates)
+{
+    m_rates = rates;
+}
+
+void LevenbergMarquardtFitter::setIterationCallback(const IterationCallback& callback)
+{
+    m_iterationCallback = callback;
+}
+
+void LevenbergMarquardtFitter::setProgressCallback(const ProgressCallback& callback)
+{
+    m_progressCallback = callback;
+}
+
+void LevenbergMarquardtFitter::setStopPredicate(const StopPredicate& predicate)
+{
+    m_stopPredicate = predicate;
+}
+
+void LevenbergMarquardtFitter::setStepCallback(const StepCallback& callback)
+{
+    m_stepCallback = callback;
+}
+
+LevenbergMarquardtFitter::Result LevenbergMarquardtFitter::fit(const QList<FitParameter>& params, const SolverConfig& config) const
+{
+    Result result;
+    for(const auto& p : params) result.params.insert(p.name, p.value);
+    updateDerivedParameters(result.params);
+    if(!m_solver) return result;
+
+    QVector<int> fitIndices;
+    for(int i=0; i<params.size(); ++i) {
+        if(params[i].isFit && params[i].name != "LfD") fitIndices.append(i);
+    }
+    int nParams = fitIndices.size();
+    if(nParams == 0) return result;
+
+    QStringList names;
+    for(int idx : fitIndices) names.append(params[idx].name);
+
+    // 迭代过程使用快速模式 (是否经由典型曲线缓存由拟合参数决定)，最终曲线使用高精度
+    const SolverConfig fitConfig = fittingConfig(config, names);
+    const SolverConfig finalConfig = config.withHighPrecision(true);
+
+    double lambda = m_options.initialLambda;
+    QMap<QString, double>& currentParamMap = result.params;
+    EvaluationStats& stats = result.stats;
+
+    QVector<double> residuals = calculateResiduals(currentParamMap, fitConfig);
+    ++stats.residualEvaluations;
+    double currentSSE = calculateSumSquaredError(residuals);
+    auto meanSquare = [&residuals](double sse) { return residuals.isEmpty() ? 0.0 : sse / residuals.size(); };
+
+    if(m_iterationCallback) {
+        ModelCurveData curve = calculateCurve(currentParamMap, QVector<double>(), fitConfig);
+        m_iterationCallback(meanSquare(currentSSE), currentParamMap, curve);
+    }
+
+    // 雅可比矩阵跨迭代保留: Broyden 模式下只在需要时完整重算
+    QVector<QVector<double>> J;
+    bool refreshJacobian = true;
+    int updatesSinceRefresh = 0;
+
+    for(int iter = 0; iter < m_options.maxIterations; ++iter) {
+        if(m_stopPredicate && m_stopPredicate()) {
+            result.stopped = true;
+            break;
+        }
+        if (!residuals.isEmpty() && meanSquare(currentSSE) < m_options.targetMse) break;
+
+        if(m_progressCallback) m_progressCallback(iter * 100 / m_options.maxIterations, stats);
+        result.iterations = iter + 1;
+
+        const bool freshJacobian = !m_options.broydenUpdates || refreshJacobian
+                                   || updatesSinceRefresh >= m_options.jacobianRefreshInterval;
+        if(freshJacobian) {
+            int cost = 0;
+            J = computeJacobian(currentParamMap, residuals, names, fitConfig, &cost);
+            ++stats.jacobianEvaluations;
+            stats.jacobianModelEvaluations += cost;
+            refreshJacobian = false;
+            updatesSinceRefresh = 0;
+        }
+        int nRes = residuals.size();
+
+        QVector<QVector<double>> H(nParams, QVector<double>(nParams, 0.0));
+        QVector<double> g(nParams, 0.0);
+
+        for(int k=0; k<nRes; ++k) {
+            for(int i=0; i<nParams; ++i) {
+                g[i] += J[k][i] * residuals[k];
+                for(int j=0; j<=i; ++j) {
+                    H[i][j] += J[k][i] * J[k][j];
+                }
+            }
+        }
+        for(int i=0; i<nParams; ++i) {
+            for(int j=i+1; j<nParams; ++j) {
+                H[i][j] = H[j][i];
+            }
+        }
+
+        bool stepAccepted = false;
+        for(int tryIter=0; tryIter<m_options.maxLambdaTries; ++tryIter) {
+            QVector<QVector<double>> H_lm = H;
+            for(int i=0; i<nParams; ++i) {
+                H_lm[i][i] += lambda * (1.0 + std::abs(H[i][i]));
+            }
+
+            QVector<double> negG(nParams);
+            for(int i=0;i<nParams;++i) negG[i] = -g[i];
+
+            QVector<double> delta = solveLinearSystem(H_lm, negG);
+            QMap<QString, double> trialMap = currentParamMap;
+            QVector<double> dx(nParams);
+
+            for(int i=0; i<nParams; ++i) {
+                int pIdx = fitIndices[i];
+                QString pName = params[pIdx].name;
+                double oldVal = currentParamMap[pName];
+                bool isLog = isLogParameter(pName, oldVal);
+                double newVal;
+
+                if(isLog) newVal = pow(10.0, log10(oldVal) + delta[i]);
+                else newVal = oldVal + delta[i];
+
+                newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
+                trialMap[pName] = newVal;
+
+                // 限幅后的实际步长 (拟合坐标)
+                dx[i] = (isLog && newVal > 0.0) ? log10(newVal) - log10(oldVal) : newVal - oldVal;
+            }
+            updateDerivedParameters(trialMap);
+
+            QVector<double> newRes = calculateResiduals(trialMap, fitConfig);
+            ++stats.residualEvaluations;
+            double newSSE = calculateSumSquaredError(newRes);
+
+            if(newSSE < currentSSE) {
+                if(m_options.broydenUpdates && newRes.size() == nRes) {
+                    // 增益比: 实际下降量 / 线性模型 |r + J·Δx|² 预测的下降量 -(2·gᵀΔx + ΔxᵀHΔx)
+                    // 按限幅后实际走过的步长 Δx 计算 (步长触及参数上下限时与 δ 不同)
+                    double predicted = 0.0;
+                    for(int i=0; i<nParams; ++i) {
+                        double hd = 0.0;
+                        for(int j=0; j<nParams; ++j) hd += H[i][j] * dx[j];
+                        predicted -= 2.0 * g[i] * dx[i] + dx[i] * hd;
+                    }
+                    double gain = predicted > 0.0 ? (currentSSE - newSSE) / predicted : 0.0;
+                    if(gain < m_options.minGainRatio) {
+                        // 线性化已不可信: 下一次迭代完整重算，秩一更新的结果会被丢弃，无需计算
+                        refreshJacobian = true;
+                    } else {
+                        QVector<double> dr(nRes);
+                        for(int k=0; k<nRes; ++k) dr[k] = newRes[k] - residuals[k];
+                        broydenUpdate(J, dx, dr);
+                        ++stats.broydenUpdates;
+                        ++updatesSinceRefresh;
+                    }
+                }
+
+                currentSSE = newSSE;
+                currentParamMap = trialMap;
+                residuals = newRes;
+                lambda /= 10.0;
+                stepAccepted = true;
+                if(m_iterationCallback) {
+                    ModelCurveData iterCurve = calculateCurve(currentParamMap, QVector<double>(), fitConfig);
+                    m_iterationCallback(meanSquare(currentSSE), currentParamMap, iterCurve);
+                }
+                break;
+            } else {
+                lambda *= 10.0;
+            }
+        }
+        if(m_stepCallback) m_stepCallback(result.iterations, meanSquare(currentSSE));
+        if(!stepAccepted) {
+            // 近似雅可比矩阵下步长被拒绝: 下一次迭代完整重算，而不是直接判定收敛失败
+            if(!freshJacobian) {
+                refreshJacobian = true;
+                continue;
+            }
+            if(lambda > m_options.maxLambda) break;
+        }
+    }
+
+    updateDerivedParameters(currentParamMap);
+    result.mse = meanSquare(currentSSE);
+    if(m_progressCallback) m_progressCallback(100, stats);
+    if(m_options.computeFinalCurve) {
+        result.curve = calculateCurve(currentParamMap, QVector<double>(), finalConfig);
+        if(m_iterationCallback) m_iterationCallback(result.mse, currentParamMap, result.curve);
+    }
+    return result;
+}
+
+QVector<double> LevenbergMarquardtFitter::calculateResiduals(const QMap<QString, double>& params, const SolverConfig& config) const
+{
+    if(!m_solver || m_obsTime.isEmpty()) return QVector<double>();
+
+    ModelCurveData res = calculateCurve(params, m_obsTime, config);
+    return calculateResiduals(res);
+}
+
+QVector<ModelCurveData> LevenbergMarquardtFitter::calculateCurves(const QVector<QMap<QString, double>>& paramSets, const QVector<double>& times,
+                                                                  const SolverConfig& config) const
+{
+    if(!m_solver) return QVector<ModelCurveData>();
+    if(m_rates.isEmpty()) return m_solver->calculateTheoreticalCurves(paramSets, times, config);
+
+    // 叠加需要绝对时间，未给定时间点时与求解器一样使用默认网格
+    const QVector<double> t = times.isEmpty() ? ModelSolver01_06::generateLogTimeSteps(100, -3.0, 3.0) : times;
+    QVector<ModelCurveData> curves;
+    curves.reserve(paramSets.size());
+    for(const QMap<QString, double>& params : paramSets) {
+        curves.append(m_rates.calculate(*m_solver, ModelSolver01_06::compileParams(params), t, config));
+    }
+    return curves;
+}
+
+ModelCurveData LevenbergMarquardtFitter::calculateCurve(const QMap<QString, double>& params, const QVector<double>& times,
+                                                        const SolverConfig& config) const
+{
+    if(!m_solver) return ModelCurveData();
+    if(m_rates.isEmpty()) return m_solver->calculateTheoreticalCurve(params, times, config);
+    return calculateCurves(QVector<QMap<QString, double>>{params}, times, config).first();
+}
+
+// 由已算好的理论曲线计算残差 (供批量计算结果复用)
+QVector<double> LevenbergMarquardtFitter::calculateResiduals(const ModelCurveData& curve) const
+{
+    const QVector<double>& pCal = std::get<1>(curve);
+    const QVector<double>& dpCal = std::get<2>(curve);
+
+    QVector<double> r;
+    double wp = m_weight;
+    double wd = 1.0 - m_weight;
+
+    int count = qMin(m_obsDeltaP.size(), pCal.size());
+    for(int i=0; i<count; ++i) {
+        if(m_obsDeltaP[i] > 1e-10 && pCal[i] > 1e-10)
+            r.append( (log(m_obsDeltaP[i]) - log(pCal[i])) * wp );
+        else
+            r.append(0.0);
+    }
+
+    int dCount = qMin(m_obsDerivative.size(), dpCal.size());
+    dCount = qMin(dCount, count);
+    for(int i=0; i<dCount; ++i) {
+        if(m_obsDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
+            r.append( (log(m_obsDerivative[i]) - log(dpCal[i])) * wd );
+        else
+            r.append(0.0);
+    }
+    return r;
+}
+
+QVector<QVector<double>> LevenbergMarquardtFitter::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals,
+                                                                   const QStringList& names, const SolverConfig& config,
+                                                                   int* modelEvaluations) const
+{
+    int nRes = baseResiduals.size();
+    int nParams = names.size();
+    QVector<QVector<double>> J(nRes, QVector<double>(nParams));
+    if(modelEvaluations) *modelEvaluations = 0;
+    if(!m_solver || m_obsTime.isEmpty()) return J;
+
+    // 优先使用前向自动微分: 一次计算得到理论曲线及其对全部拟合参数的精确偏导数。
+    // 残差经由典型曲线缓存计算时改用差分，使雅可比矩阵与残差对应同一条 (插值) 曲线；
+    // 此时扰动只改变换算参数，差分曲线均命中缓存，几乎不需要反演。变产量叠加没有对应的敏感度计算，同样使用差分
+    ModelSensitivity sens;
+    if(!config.useTypeCurveCache && m_rates.isEmpty() && m_solver->calculateSensitivities(params, names, m_obsTime, sens, config)) {
+        if(modelEvaluations) *modelEvaluations = (nParams + 7) / 8;
+        const QVector<double>& pCal = std::get<1>(sens.curve);
+        const QVector<double>& dpCal = std::get<2>(sens.curve);
+        double wp = m_weight;
+        double wd = 1.0 - m_weight;
+
+        // 与 calculateResiduals 的残差排列一致: 先压力，后导数
+        int count = qMin(m_obsDeltaP.size(), pCal.size());
+        int dCount = qMin(qMin(m_obsDerivative.size(), dpCal.size()), count);
+        if(count + dCount == nRes) {
+            for(int j = 0; j < nParams; ++j) {
+                QString pName = names[j];
+                double val = params.value(pName);
+                // 对数参数对 log10(x) 求导: ∂/∂log10(x) = x·ln10·∂/∂x
+                double scale = isLogParameter(pName, val) ? val * log(10.0) : 1.0;
+
+                // r = (ln obs - ln cal)·w，∂r/∂x = -w·(∂cal/∂x)/cal
+                for(int i=0; i<count; ++i) {
+                    if(m_obsDeltaP[i] > 1e-10 && pCal[i] > 1e-10)
+                        J[i][j] = -wp * sens.dPressure[j][i] / pCal[i] * scale;
+                    else
+                        J[i][j] = 0.0;
+                }
+                for(int i=0; i<dCount; ++i) {
+                    if(m_obsDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
+                        J[count + i][j] = -wd * sens.dDerivative[j][i] / dpCal[i] * scale;
+                    else
+                        J[count + i][j] = 0.0;
+                }
+            }
+            return J;
+        }
+    }
+
+    // 反演方法不支持自动微分时 (复数节点) 退回中心差分
+    // 先组装全部 2*nParams 组扰动参数，再一次性批量计算，所有曲线的计算任务合并并行调度
+    QVector<QMap<QString, double>> paramSets;
+    QVector<double> steps(nParams);
+    paramSets.reserve(2 * nParams);
+
+    for(int j = 0; j < nParams; ++j) {
+        QString pName = names[j];
+        double val = params.value(pName);
+
+        double h;
+        QMap<QString, double> pPlus = params;
+        QMap<QString, double> pMinus = params;
+
+        if(isLogParameter(pName, val)) {
+            h = 0.01;
+            double valLog = log10(val);
+            pPlus[pName] = pow(10.0, valLog + h);
+            pMinus[pName] = pow(10.0, valLog - h);
+        } else {
+            h = 1e-4;
+            pPlus[pName] = val + h;
+            pMinus[pName] = val - h;
+        }
+
+        if(pName == "L" || pName == "Lf") { updateDerivedParameters(pPlus); updateDerivedParameters(pMinus); }
+
+        steps[j] = h;
+        paramSets.append(pPlus);
+        paramSets.append(pMinus);
+    }
+
+    QVector<ModelCurveData> curves = calculateCurves(paramSets, m_obsTime, config);
+    if(modelEvaluations) *modelEvaluations = paramSets.size();
+
+    for(int j = 0; j < nParams; ++j) {
+        double h = steps[j];
+        QVector<double> rPlus = calculateResiduals(curves[2 * j]);
+        QVector<double> rMinus = calculateResiduals(curves[2 * j + 1]);
+
+        if(rPlus.size() == nRes && rMinus.size() == nRes) {
+            for(int i=0; i<nRes; ++i) {
+                J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * h);
+            }
+        }
+    }
+    return J;
+}
+
+QVector<double> LevenbergMarquardtFitter::solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b)
+{
+    int n = b.size();
+    if (n == 0) return QVector<double>();
+
+    Eigen::MatrixXd matA(n, n);
+    Eigen::VectorXd vecB(n);
+
+    for (int i = 0; i < n; ++i) {
+        vecB(i) = b[i];
+        for (int j = 0; j < n; ++j) {
+            matA(i, j) = A[i][j];
+        }
+    }
+
+    Eigen::VectorXd x = matA.ldlt().solve(vecB);
+
+    QVector<double> res(n);
+    for (int i = 0; i < n; ++i) res[i] = x(i);
+    return res;
+}
+
+void LevenbergMarquardtFitter::broydenUpdate(QVector<QVector<double>>& J, const QVector<double>& dx, const QVector<double>& dr)
+{
+    double dxNorm2 = 0.0;
+    for(double v : dx) dxNorm2 += v * v;
+    if(!(dxNorm2 > 0.0) || J.size() != dr.size()) return;
+
+    for(int k=0; k<J.size(); ++k) {
+        double predicted = 0.0;
+        for(int i=0; i<dx.size(); ++i) predicted += J[k][i] * dx[i];
+        const double scale = (dr[k] - predicted) / dxNorm2;
+        for(int i=0; i<dx.size(); ++i) J[k][i] += scale * dx[i];
+    }
+}
+
+double LevenbergMarquardtFitter::calculateSumSquaredError(const QVector<double>& residuals)
+{
+    double sse = 0.0;
+    for(double v : residuals) sse += v*v;
+    return sse;
+}
+
+SolverConfig LevenbergMarquardtFitter::fittingConfig(const SolverConfig& config, const QStringList& names)
+{
+    // 缓存只在全部拟合参数均为换算参数时有益: 其余参数每次试算都改变缓存键，
+    // 未命中时要在观测时间范围两端各扩展一个十倍程的稠密网格上反演，比直接在观测时间点上计算更慢
+    bool scaleOnly = !names.isEmpty();
+    for(const QString& name : names) {
+        if(!ModelSolver01_06::isScaleOnlyParameter(name)) {
+            scaleOnly = false;
+            break;
+        }
+    }
+    return config.withHighPrecision(false).withTypeCurveCache(scaleOnly);
+}
+
+bool LevenbergMarquardtFitter::isLogParameter(const QString& name, double value)
+{
+    return value > 1e-12 && name != "S" && name != "nf";
+}
+
+void LevenbergMarquardtFitter::updateDerivedParameters(QMap<QString, double>& params)
+{
+    if(params.contains("L") && params.contains("Lf") && params["L"] > 1e-9)
+        params["LfD"] = params["Lf"] / params["L"];
+}
@@ -0,0 +1,151 @@
+/*
+ * levenbergmarquardtfitter.h
+ * 文件作用: Levenberg-Marquardt 非线性回归拟合器头文件 (属于 welltest_core 库，不依赖界面)
+ * 功能描述:
+ * 1. 定义拟合参数结构体 FitParameter (界面参数表与拟合器共用)。
+ * 2. 以对数压差、对数导数的加权残差平方和为目标，拟合 ModelSolver01_06 的理论曲线。
+ * 3. 雅可比矩阵优先由前向自动微分精确计算，反演方法不支持时退回中心差分 (扰动曲线批量并行计算)。
+ * 4. 迭代中间结果、进度与停止请求通过回调函数传递，既可在界面工作线程中使用，也可用于批处理程序。
+ * 5. 可选的拟牛顿模式: 步长被接受后以 Broyden 秩一公式由残差变化更新雅可比矩阵，
+ *    只在间隔若干次迭代、步长被拒绝或增益比过低时重新完整计算；进度回调报告各部分消耗的模型计算次数。
+ * 6. 可设置变产量史 (RateSuperposition)，此时残差与曲线均按叠加原理计算，雅可比矩阵使用差分。
+ */
+
+#ifndef LEVENBERGMARQUARDTFITTER_H
+#define LEVENBERGMARQUARDTFITTER_H
+
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+#include "modelsolver01-06.h"
+#include "ratesuperposition.h"
+
+// 定义拟合参数结构体
+struct FitParameter {
+    QString name;           // 参数内部标识 (如 "kf")
+    QString displayName;    // 参数显示名称 (如 "内区渗透率")
+    double value = 0.0;     // 当前值
+    bool isFit = false;     // 是否参与拟合
+    double min = 0.0;       // 最小值限制
+    double max = 100.0;     // 最大值限制
+    bool isVisible = true;  // 是否在表格中显示
+    double step = 0.1;      // 滚轮调节步长
+};
+
+class LevenbergMarquardtFitter
+{
+public:
+    // 迭代控制选项 (默认值与原拟合界面一致)
+    struct Options {
+        int maxIterations = 50;         // 最大迭代次数
+        double initialLambda = 0.01;    // 初始阻尼系数
+        int maxLambdaTries = 5;         // 每次迭代内增大阻尼重试的最多次数
+        double maxLambda = 1e10;        // 阻尼超过该值且步长未被接受时结束
+        double targetMse = 3e-3;        // 平均残差平方低于该值时提前结束
+
+        // 拟牛顿 (Broyden 秩一更新) 模式，默认关闭 (每次迭代完整计算雅可比矩阵)
+        bool broydenUpdates = false;
+        int jacobianRefreshInterval = 5;    // 连续 Broyden 更新的最多次数，达到后完整重算
+        double minGainRatio = 0.25;         // 实际下降量与线性化预测下降量之比低于该值时下一次完整重算
+
+        bool computeFinalCurve = true;      // 结束时是否以高精度计算最终理论曲线 (多起点拟合中只为最优解计算)
+    };
+
+    // 模型计算次数统计
+    struct EvaluationStats {
+        int residualEvaluations = 0;        // 残差 (观测时间点上的理论曲线) 计算次数
+        int jacobianEvaluations = 0;        // 完整雅可比矩阵计算次数
+        int jacobianModelEvaluations = 0;   // 完整雅可比矩阵消耗的模型计算次数 (差分每参数 2 条曲线，自动微分每 8 个参数 1 遍)
+        int broydenUpdates = 0;             // Broyden 秩一更新次数 (不需模型计算)
+
+        int modelEvaluations() const { return residualEvaluations + jacobianModelEvaluations; }
+    };
+
+    // 拟合结果
+    struct Result {
+        QMap<QString, double> params;   // 拟合后的全部参数 (含派生参数 LfD)
+        double mse = 0.0;               // 平均残差平方 (迭代所用快速模式下的值)
+        int iterations = 0;             // 完成的迭代次数
+        bool stopped = false;           // 是否因停止请求提前结束
+        EvaluationStats stats;          // 模型计算次数统计
+        ModelCurveData curve;           // 高精度计算的最终理论曲线 (求解器默认时间网格，computeFinalCurve 为 false 时为空)
+    };
+
+    // 回调: 每次接受新参数时给出平均残差平方、当前参数与理论曲线 (在拟合线程中调用)
+    using IterationCallback = std::function<void(double mse, const QMap<QString, double>& params, const ModelCurveData& curve)>;
+    using ProgressCallback = std::function<void(int percent, const EvaluationStats& stats)>;
+    using StopPredicate = std::function<bool()>;
+    // 回调: 每次迭代结束时给出已完成的迭代次数与当前平均残差平方 (不计算曲线，开销可忽略)
+    using StepCallback = std::function<void(int iteration, double mse)>;
+
+    explicit LevenbergMarquardtFitter(ModelSolver01_06* solver);
+
+    // 观测数据 (时间、压差、导数)
+    void setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative);
+    // 压差残差权重 weight，导数残差权重 1 - weight
+    void setWeight(double weight);
+    void setOptions(const Options& options);
+    // 变产量史 (分段恒定产量)，为空时按恒定产量 q 计算
+    void setRateSchedule(const RateSuperposition& rates);
+
+    void setIterationCallback(const IterationCallback& callback);
+    void setProgressCallback(const ProgressCallback& callback);
+    void setStopPredicate(const StopPredicate& predicate);
+    void setStepCallback(const StepCallback& callback);
+
+    // 执行拟合: 迭代过程使用 config 的快速模式，最终曲线使用高精度；config 按次传入，不修改求解器默认配置
+    Result fit(const QList<FitParameter>& params, const SolverConfig& config) const;
+
+    // 理论曲线: 设置了变产量史时逐组按叠加原理计算，否则批量并行计算；times 为空时使用求解器默认时间网格
+    QVector<ModelCurveData> calculateCurves(const QVector<QMap<QString, double>>& paramSets, const QVector<double>& times,
+                                            const SolverConfig& config) const;
+    ModelCurveData calculateCurve(const QMap<QString, double>& params, const QVector<double>& times, const SolverConfig& config) const;
+
+    // 残差: 先压差后导数，r = (ln 观测值 - ln 计算值)·权重，任一侧非正时为 0
+    QVector<double> calculateResiduals(const QMap<QString, double>& params, const SolverConfig& config) const;
+    QVector<double> calculateResiduals(const ModelCurveData& curve) const;
+
+    // 雅可比矩阵 (残差对 names 中各参数的偏导数，对数参数对 log10(x) 求导)
+    // config 经由典型曲线缓存或设置了变产量史时使用差分，与残差的计算路径一致
+    // modelEvaluations 非空时写入本次消耗的模型计算次数
+    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals,
+                                             const QStringList& names, const SolverConfig& config,
+                                             int* modelEvaluations = nullptr) const;
+
+    // Broyden 秩一更新: J += (Δr - J·Δx)·Δxᵀ / (Δxᵀ·Δx)，Δx 为拟合坐标 (对数参数取 log10) 上的实际步长
+    static void broydenUpdate(QVector<QVector<double>>& J, const QVector<double>& dx, const QVector<double>& dr);
+
+    // 求解对称正定线性方程组 (LDLT 分解)
+    static QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
+
+    // 平方误差和
+    static double calculateSumSquaredError(const QVector<double>& residuals);
+
+    // 迭代所用配置: 快速模式；全部拟合参数均为换算参数 (phi、mu、B、Ct、q、h) 时经由典型曲线缓存计算，否则直接计算
+    static SolverConfig fittingConfig(const SolverConfig& config, const QStringList& names);
+
+    // 参数是否按对数尺度更新 (正值且非表皮系数、裂缝条数)
+    static bool isLogParameter(const QString& name, double value);
+
+    // 由 L、Lf 更新派生参数 LfD
+    static void updateDerivedParameters(QMap<QString, double>& params);
+
+private:
+    ModelSolver01_06* m_solver;
+    QVector<double> m_obsTime;
+    QVector<double> m_obsDeltaP;
+    QVector<double> m_obsDerivative;
+    double m_weight;
+    Options m_options;
+    RateSuperposition m_rates;
+
+    IterationCallback m_iterationCallback;
+    ProgressCallback m_progressCallback;
+    StopPredicate m_stopPredicate;
+    StepCallback m_stepCallback;
+};
+
+#endif // LEVENBERGMARQUARDTFITTER_H
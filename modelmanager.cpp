@@ -12,6 +12,7 @@
 #include "modelparameter.h"
 #include "wt_modelwidget.h"
 #include "modelsolver01-06.h"
+#include "typecurvecache.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -58,6 +59,7 @@ void ModelManager::initializeModels(QWidget* parentWidget)
         connect(widget, &WT_ModelWidget::requestModelSelection, this, &ModelManager::onSelectModelClicked);
 
         // 2. 创建独立的求解器对象，用于后台/拟合计算
+        // 典型曲线缓存默认关闭: 拟合器只在全部拟合参数均为换算参数时按次启用 (见 LevenbergMarquardtFitter::fittingConfig)
         ModelSolver01_06* solver = new ModelSolver01_06(type);
         m_solvers.append(solver);
     }
@@ -143,6 +145,43 @@ void ModelManager::setHighPrecision(bool high) {
     }
 }
 
+void ModelManager::setInversionMethod(ModelType type, LaplaceInversion::Method method)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_modelWidgets.size()) {
+        m_modelWidgets[index]->setInversionMethod(method);
+    }
+    if (index >= 0 && index < m_solvers.size()) {
+        m_solvers[index]->setInversionMethod(method);
+    }
+}
+
+LaplaceInversion::Method ModelManager::inversionMethod(ModelType type) const
+{
+    return solverConfig(type).inversionMethod;
+}
+
+void ModelManager::setParallelEnabled(bool enabled)
+{
+    for(ModelSolver01_06* s : m_solvers) {
+        s->setParallelEnabled(enabled);
+    }
+}
+
+void ModelManager::setTypeCurveCacheEnabled(bool enabled)
+{
+    for(ModelSolver01_06* s : m_solvers) {
+        s->setTypeCurveCacheEnabled(enabled);
+    }
+}
+
+void ModelManager::clearTypeCurveCache()
+{
+    for(ModelSolver01_06* s : m_solvers) {
+        if (s->typeCurveCache()) s->typeCurveCache()->clear();
+    }
+}
+
 void ModelManager::updateAllModelsBasicParameters()
 {
     for(WT_ModelWidget* w : m_modelWidgets) {
@@ -191,6 +230,7 @@ QMap<QString, double> ModelManager::getDefaultParameters(ModelType type)
 }
 
 // [核心修改] 使用独立的 Solver 进行计算，不再调用 Widget 方法
+// 可重入: 求解器列表在 initializeModels 之后不再改变，求解器计算过程只读传入 (或复制得到) 的配置
 ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime)
 {
     int index = (int)type;
@@ -201,6 +241,83 @@ ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMa
     return ModelCurveData();
 }
 
+QVector<ModelCurveData> ModelManager::calculateTheoreticalCurves(ModelType type, const QVector<QMap<QString, double>>& paramSets, const QVector<double>& providedTime)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurves(paramSets, providedTime);
+    }
+    return QVector<ModelCurveData>(paramSets.size());
+}
+
+ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                                       const SolverConfig& config)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurve(params, providedTime, config);
+    }
+    return ModelCurveData();
+}
+
+QVector<ModelCurveData> ModelManager::calculateTheoreticalCurves(ModelType type, const QVector<QMap<QString, double>>& paramSets, const QVector<double>& providedTime,
+                                                                 const SolverConfig& config)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateTheoreticalCurves(paramSets, providedTime, config);
+    }
+    return QVector<ModelCurveData>(paramSets.size());
+}
+
+bool ModelManager::calculateSensitivities(ModelType type, const QMap<QString, double>& params, const QStringList& names,
+                                          const QVector<double>& providedTime, ModelSensitivity& out)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateSensitivities(params, names, providedTime, out);
+    }
+    return false;
+}
+
+bool ModelManager::calculateSensitivities(ModelType type, const QMap<QString, double>& params, const QStringList& names,
+                                          const QVector<double>& providedTime, ModelSensitivity& out, const SolverConfig& config)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->calculateSensitivities(params, names, providedTime, out, config);
+    }
+    return false;
+}
+
+ModelCurveData ModelManager::calculateVariableRateCurve(ModelType type, const QMap<QString, double>& params, const RateSuperposition& rates,
+                                                        const QVector<double>& times, const SolverConfig& config)
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return rates.calculate(*m_solvers[index], ModelSolver01_06::compileParams(params), times, config);
+    }
+    return ModelCurveData();
+}
+
+SolverConfig ModelManager::solverConfig(ModelType type) const
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index]->config();
+    }
+    return SolverConfig();
+}
+
+ModelSolver01_06* ModelManager::solver(ModelType type) const
+{
+    int index = (int)type;
+    if (index >= 0 && index < m_solvers.size()) {
+        return m_solvers[index];
+    }
+    return nullptr;
+}
+
 QVector<double> ModelManager::generateLogTimeSteps(int count, double startExp, double endExp) {
     // 委托给 Solver 的静态方法
     return ModelSolver01_06::generateLogTimeSteps(count, startExp, endExp);
@@ -5,6 +5,8 @@
  * 1. 管理所有试井模型界面 (WT_ModelWidget) 的显示与切换。
  * 2. 管理所有数学模型求解器 (ModelSolver01_06) 的实例与计算。
  * 3. 协调模型计算请求，实现界面与算法的解耦。
+ * 4. 计算接口可重入：多个拟合页、敏感性分析与模型预览可同时调用；需要不同精度或反演方法时
+ *    按次传入 SolverConfig，不修改共享求解器的默认配置。
  */
 
 #ifndef MODELMANAGER_H
@@ -19,6 +21,7 @@
 // 引入新的界面类和求解器类头文件
 #include "wt_modelwidget.h"
 #include "modelsolver01-06.h"
+#include "ratesuperposition.h"
 
 class ModelManager : public QObject
 {
@@ -49,12 +52,48 @@ public:
     // 核心计算接口：代理给对应的 Solver 进行计算 (线程安全，可在拟合线程调用)
     ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
 
+    // 批量计算接口：一次计算多组参数的理论曲线 (敏感性分析、雅可比矩阵)，全部任务合并并行调度
+    QVector<ModelCurveData> calculateTheoreticalCurves(ModelType type, const QVector<QMap<QString, double>>& paramSets, const QVector<double>& providedTime = QVector<double>());
+
+    // 敏感度接口：理论曲线及其对 names 中各参数的精确偏导数 (前向自动微分)，反演方法不支持时返回 false
+    bool calculateSensitivities(ModelType type, const QMap<QString, double>& params, const QStringList& names,
+                                const QVector<double>& providedTime, ModelSensitivity& out);
+
+    // 按次指定配置的计算接口 (可重入)：不读写求解器默认配置，供拟合线程等使用独立配置
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                             const SolverConfig& config);
+    QVector<ModelCurveData> calculateTheoreticalCurves(ModelType type, const QVector<QMap<QString, double>>& paramSets, const QVector<double>& providedTime,
+                                                       const SolverConfig& config);
+    bool calculateSensitivities(ModelType type, const QMap<QString, double>& params, const QStringList& names,
+                                const QVector<double>& providedTime, ModelSensitivity& out, const SolverConfig& config);
+
+    // 变产量计算接口：单位产量响应只计算一次，按产量史 rates 叠加得到各时间点的压差与导数
+    ModelCurveData calculateVariableRateCurve(ModelType type, const QMap<QString, double>& params, const RateSuperposition& rates,
+                                              const QVector<double>& times, const SolverConfig& config);
+
+    // 后台求解器当前默认配置的副本 (拟合开始时取一份，在其基础上修改后按次传入)
+    SolverConfig solverConfig(ModelType type) const;
+
+    // 后台求解器 (不依赖界面，供 welltest_core 中的拟合器等直接使用；计算接口可重入，所有权仍归 ModelManager)
+    ModelSolver01_06* solver(ModelType type) const;
+
     // 获取默认参数
     QMap<QString, double> getDefaultParameters(ModelType type);
 
     // 设置全局计算精度
     void setHighPrecision(bool high);
 
+    // 按模型设置/获取拉普拉斯数值反演方法 (界面与后台求解器同步)
+    void setInversionMethod(ModelType type, LaplaceInversion::Method method);
+    LaplaceInversion::Method inversionMethod(ModelType type) const;
+
+    // 设置后台求解器是否并行计算 (结果与串行一致)
+    void setParallelEnabled(bool enabled);
+
+    // 后台求解器的无因次典型曲线缓存 (默认关闭；拟合时按拟合参数自动决定是否使用)
+    void setTypeCurveCacheEnabled(bool enabled);
+    void clearTypeCurveCache();
+
     // 刷新所有界面模型的参数显示
     void updateAllModelsBasicParameters();
 
@@ -5,6 +5,18 @@
  * 1. 定义模型类型枚举 (ModelType) 和曲线数据类型 (ModelCurveData)。
  * 2. 声明纯数学计算逻辑，包括拉普拉斯变换、贝塞尔函数计算、Stehfest 数值反演等。
  * 3. 不依赖任何 UI 控件，仅负责数据输入与结果输出。
+ * 4. 定义预编译参数块 ModelParams，拉普拉斯核函数只访问该结构体，避免逐次按字符串查找参数。
+ * 5. 数值反演方法可切换 (Stehfest / Talbot / de Hoog / Euler，见 laplaceinversion.h)，
+ *    核函数以模板形式同时支持实数节点与复数节点。
+ * 6. 各拉普拉斯节点相互独立，可在共享线程池上并行计算 (见 solverthreadpool.h)，结果与串行一致。
+ * 7. 提供批量接口，一次调用计算多组参数的理论曲线 (敏感性分析、雅可比矩阵等)。
+ * 8. 核函数按外边界与井储策略模板特化，计算过程中不再逐次判断模型类型。
+ * 9. 可启用无因次典型曲线缓存 (见 typecurvecache.h)，只改变换算参数时无需重新反演。
+ * 10. 核函数可用对偶数 (dualnumber.h) 实例化，一次计算同时得到理论曲线及其对各参数的精确偏导数。
+ * 11. 自适应时间网格: 粗网格起步，只在双对数插值误差超限的区间加密，任意时间点由单调三次插值取值。
+ * 12. 早期 (大拉普拉斯参数) 与晚期 (小参数) 节点走渐近快速路径，适用阈值由截断误差限控制。
+ * 13. 计算配置 (精度、反演方法、并行、渐近误差限、缓存) 集中为不可变值类型 SolverConfig，
+ *     可按次传入；计算过程不修改求解器成员，同一求解器可被多个拟合线程与界面同时调用。
  */
 
 #ifndef MODELSOLVER01_06_H
@@ -13,12 +25,86 @@
 #include <QMap>
 #include <QVector>
 #include <QString>
+#include <QStringList>
+#include <complex>
 #include <tuple>
 #include <functional>
+#include <memory>
+#include <QMutex>
+#include "laplaceinversion.h"
+
+class TypeCurveCache;
 
 // 类型定义: <时间, 压力, 导数>
 using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
 
+// 参数敏感度: 理论曲线及其对指定参数的偏导数
+// dPressure[j][i] = ∂Δp(t_i)/∂参数j，dDerivative[j][i] = ∂Δp'(t_i)/∂参数j
+struct ModelSensitivity
+{
+    ModelCurveData curve;
+    QVector<QVector<double>> dPressure;
+    QVector<QVector<double>> dDerivative;
+};
+
+// 预编译模型参数块
+// 由 QMap<QString,double> 参数表在每条曲线计算前一次性转换得到，
+// 同时预先计算好派生量 (M12、LfD、裂缝位置、时间/压力换算系数)。
+// 拉普拉斯空间核函数在每个 Stehfest 项上都会被调用，只以常引用方式访问该结构体。
+struct ModelParams
+{
+    // 物理参数 (用于无因次量与物理量之间的换算)
+    double phi = 0.05;      // 孔隙度
+    double mu = 0.5;        // 粘度 (mPa·s)
+    double B = 1.05;        // 体积系数
+    double Ct = 5e-4;       // 综合压缩系数 (1/MPa)
+    double q = 5.0;         // 产量 (m³/d)
+    double h = 20.0;        // 有效厚度 (m)
+    double kf = 1e-3;       // 内区渗透率 (mD)
+    double km = 0.0;        // 外区渗透率 (mD)
+    double L = 1000.0;      // 水平井长度 (m)
+    double Lf = 0.0;        // 裂缝半长 (m)
+
+    // 无因次模型参数
+    double rmD = 0.0;       // 无因次复合半径
+    double reD = 0.0;       // 无因次边界半径
+    double omega1 = 0.0;    // 储容比 1
+    double omega2 = 0.0;    // 储容比 2
+    double lambda1 = 0.0;   // 窜流系数
+    double cD = 0.0;        // 无因次井储系数
+    double S = 0.0;         // 表皮系数
+    double gamaD = 0.0;     // 无因次压敏系数
+    int nf = 4;             // 裂缝条数 (>= 1)
+    int N = 4;              // Stehfest 反演项数 (参数表中的 "N")
+
+    // 派生量 (由 ModelSolver01_06::compileParams 计算)
+    double M12 = 0.0;       // 流度比 kf / km
+    double LfD = 0.0;       // 无因次缝长 Lf / L (L 无效时取参数表中的 LfD)
+    double tdCoeff = 0.0;   // 无因次时间系数: tD = tdCoeff * t
+    double pCoeff = 0.0;    // 压力换算系数: dp = pCoeff * pD
+    QVector<double> xwD;    // 各条裂缝的无因次位置 (沿井筒等间距分布)
+};
+
+// 求解器计算配置 (值类型)
+// 每次计算开始时取一份副本，整个计算过程只读该副本；需要不同配置时复制后修改再按次传入，
+// 不必修改共享求解器的状态 (例如拟合线程使用快速模式，界面仍为高精度)。
+struct SolverConfig
+{
+    bool highPrecision = true;                                      // 高精度 (Stehfest 使用参数表中的 N)
+    LaplaceInversion::Method inversionMethod = LaplaceInversion::Stehfest; // 数值反演方法
+    bool parallel = true;                                           // 各拉普拉斯节点并行计算
+    int inversionOrder = 0;                                         // 反演阶数 (<= 0 时 Stehfest 取参数表中的 N，其余方法取默认阶数)
+    double quadratureTolerance = 1e-10;                             // 裂缝积分的相对误差限
+    double asymptoticTolerance = 1e-10;                             // 渐近快速路径截断误差限 (<= 0 关闭)
+    bool useTypeCurveCache = false;                                 // 经由典型曲线缓存计算
+
+    // 以某一项不同的新配置 (原配置不变)
+    SolverConfig withHighPrecision(bool high) const { SolverConfig c = *this; c.highPrecision = high; return c; }
+    SolverConfig withInversionMethod(LaplaceInversion::Method method) const { SolverConfig c = *this; c.inversionMethod = method; return c; }
+    SolverConfig withParallel(bool enabled) const { SolverConfig c = *this; c.parallel = enabled; return c; }
+    SolverConfig withTypeCurveCache(bool enabled) const { SolverConfig c = *this; c.useTypeCurveCache = enabled; return c; }
+};
+
 class ModelSolver01_06
 {
 public:
@@ -36,11 +122,91 @@ public:
     explicit ModelSolver01_06(ModelType type);
     virtual ~ModelSolver01_06();
 
+    // 默认计算配置: 不带配置参数的计算接口使用调用时刻的配置副本
+    // (读写均加锁，计算过程中修改配置不影响正在进行的计算)
+    SolverConfig config() const;
+    void setConfig(const SolverConfig& config);
+
+    // 以下设置函数修改默认配置中的对应项
     // 设置计算精度
     void setHighPrecision(bool high);
 
+    // 设置/获取拉普拉斯数值反演方法 (默认 Stehfest)
+    void setInversionMethod(LaplaceInversion::Method method);
+    LaplaceInversion::Method inversionMethod() const;
+
+    // 设置是否并行计算各时间点 (默认开启，结果与串行计算逐位一致)
+    void setParallelEnabled(bool enabled);
+    bool isParallelEnabled() const;
+
+    // 设置/获取渐近快速路径的截断误差限 (默认 1e-10，<= 0 时关闭，所有节点都走完整积分解)
+    // 早期取线性流极限，晚期用 Bessel 级数逐项解析积分 (含外边界)，误差限内与完整解一致
+    void setAsymptoticTolerance(double tolerance);
+    double asymptoticTolerance() const;
+
     // 核心计算接口：根据参数和时间序列计算理论曲线
+    // (QMap 版本仅作为边界适配层，内部转换为 ModelParams 后调用下方重载)
     ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+    ModelCurveData calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime = QVector<double>());
+
+    // 批量计算接口：多组参数共用同一时间序列，所有计算任务合并后一次性并行调度
+    // 返回结果与逐组调用 calculateTheoreticalCurve 逐位一致
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<QMap<QString, double>>& paramSets, const QVector<double>& providedTime = QVector<double>());
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<ModelParams>& paramSets, const QVector<double>& providedTime = QVector<double>());
+
+    // 自适应时间网格计算：在 [tMin, tMax] 上先计算粗对数网格，再只在压力或导数的双对数插值误差
+    // 超过 tolerance (对数误差，1e-3 约为 0.1%) 的区间二分加密，总点数不超过 maxPoints。
+    // 返回的时间点非均匀分布：直线段稀疏，流动阶段过渡处密集。
+    ModelCurveData calculateAdaptiveCurve(const QMap<QString, double>& params, double tMin, double tMax,
+                                          double tolerance = 1e-3, int maxPoints = 2000);
+    ModelCurveData calculateAdaptiveCurve(const ModelParams& params, double tMin, double tMax,
+                                          double tolerance = 1e-3, int maxPoints = 2000);
+
+    // 在任意时间点上对已计算曲线做单调三次 (Fritsch-Carlson) 插值，
+    // 曲线全部为正时在双对数空间插值；超出曲线时间范围的点取端点值
+    static ModelCurveData interpolateCurve(const ModelCurveData& curve, const QVector<double>& times);
+
+    // 敏感度接口：前向自动微分一次得到理论曲线及其对 names 中各参数的精确偏导数 (非有限差分)
+    // 只支持实数节点的反演方法 (Stehfest)，其余方法返回 false，由调用方改用差分
+    bool calculateSensitivities(const QMap<QString, double>& params, const QStringList& names,
+                                const QVector<double>& providedTime, ModelSensitivity& out);
+
+    // 带配置参数的重载: 按传入配置计算，不读写求解器的默认配置 (可重入，可在任意线程并发调用)
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                             const SolverConfig& config);
+    ModelCurveData calculateTheoreticalCurve(const ModelParams& params, const QVector<double>& providedTime,
+                                             const SolverConfig& config);
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<QMap<QString, double>>& paramSets,
+                                                       const QVector<double>& providedTime, const SolverConfig& config);
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<ModelParams>& paramSets,
+                                                       const QVector<double>& providedTime, const SolverConfig& config);
+    ModelCurveData calculateAdaptiveCurve(const ModelParams& params, double tMin, double tMax,
+                                          double tolerance, int maxPoints, const SolverConfig& config);
+    bool calculateSensitivities(const QMap<QString, double>& params, const QStringList& names,
+                                const QVector<double>& providedTime, ModelSensitivity& out, const SolverConfig& config);
+
+    // 无因次典型曲线缓存 (默认关闭)。启用后按无因次参数组缓存 pD(tD) 曲线，
+    // 只改变 phi、mu、B、Ct、q、h 时直接平移插值，结果与直接反演的差别在插值精度以内。
+    // 缓存对象在求解器生存期内始终存在 (内部加锁)，关闭只清空内容，不会在其他线程使用时被释放
+    void setTypeCurveCacheEnabled(bool enabled);
+    bool isTypeCurveCacheEnabled() const;
+    TypeCurveCache* typeCurveCache() const;
+    // 参数是否只改变时间、压力换算系数 (phi、mu、B、Ct、q、h)，即改变后可命中典型曲线缓存
+    static bool isScaleOnlyParameter(const QString& name);
+
+    // 将参数表一次性编译为 ModelParams (提取参数并计算派生量)
+    static ModelParams compileParams(const QMap<QString, double>& params);
+    // 压力换算系数 pCoeff (与产量 q 成正比，改变 q 后可据此重新计算)
+    static double pressureCoefficient(const ModelParams& params);
+
+    // 单个拉普拉斯节点 s 上的核函数值 (基准测试、精度检查用)
+    // withStorage 为 false 时返回不含井储与表皮的点源叠加解 (PWD_composite)
+    LaplaceInversion::Complex laplaceValue(const LaplaceInversion::Complex& s, const ModelParams& params,
+                                           const SolverConfig& config, bool withStorage = true) const;
+
+    // 核函数累计计算次数 (全部求解器共用的原子计数器)
+    static qint64 laplaceEvaluationCount();
+    static void resetLaplaceEvaluationCount();
 
     // 获取模型名称（静态辅助函数）
     static QString getModelName(ModelType type);
@@ -49,27 +215,66 @@ public:
     static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
 
 private:
-    // 计算无因次压力和导数
-    void calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                             std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                             QVector<double>& outPD, QVector<double>& outDeriv);
+    // 单组参数的反演任务: 有效时间点、反演器、拉普拉斯节点及其核函数值
+    struct InversionJob {
+        QVector<double> tD;                             // 全部无因次时间
+        QVector<int> validIdx;                          // 参与反演的时间点下标 (tD > 0)
+        QVector<double> validT;                         // 参与反演的无因次时间
+        int order = 0;                                  // 反演阶数
+        std::shared_ptr<LaplaceInversion> inverter;     // 反演器 (相同节点的任务间共享)
+        QVector<LaplaceInversion::Complex> nodes;       // 拉普拉斯节点
+        QVector<LaplaceInversion::Complex> values;      // 节点处核函数值
+    };
+
+    // 计算无因次压力和导数 (准备节点 -> 计算核函数 -> 反演组合)
+    // 以下私有函数只读取 const 成员 m_type 与传入的配置，不修改求解器状态
+    static int inversionOrder(const ModelParams& params, const SolverConfig& config);
+    static void prepareInversion(const QVector<double>& tD, const ModelParams& params, const SolverConfig& config,
+                                 InversionJob& job, const InversionJob* previous);
+    void evaluateNodes(const QVector<ModelParams>& paramSets, QVector<InversionJob>& jobs, const SolverConfig& config) const;
+    template <typename Boundary, typename Storage>
+    static void evaluateNodesFor(const QVector<ModelParams>& paramSets, QVector<InversionJob>& jobs, const SolverConfig& config);
+    // 对偶数核函数: z 的导数由时间换算系数的对数导数 tdSeeds[b] 给出 (∂s/∂ln tdCoeff = -s)；
+    // blocks 为各参数块 (雅可比矩阵的各组列)，全部块与节点一次并行计算，values[b][j] 为第 b 块第 j 个节点的值
+    template <typename Params, typename Scalar>
+    void evaluateDualNodes(const QVector<Params>& blocks, const QVector<LaplaceInversion::Complex>& nodes,
+                           const QVector<QVector<double>>& tdSeeds, QVector<QVector<Scalar>>& values,
+                           const SolverConfig& config) const;
+    template <typename Boundary, typename Storage, typename Params, typename Scalar>
+    static void evaluateDualNodesFor(const QVector<Params>& blocks, const QVector<LaplaceInversion::Complex>& nodes,
+                                     const QVector<QVector<double>>& tdSeeds, QVector<QVector<Scalar>>& values,
+                                     const SolverConfig& config);
+    template <typename Boundary, typename Storage>
+    static LaplaceInversion::Complex laplaceValueFor(const LaplaceInversion::Complex& s, const ModelParams& params,
+                                                     const SolverConfig& config, bool withStorage);
+    static void finishInversion(InversionJob& job, const ModelParams& params,
+                                QVector<double>& outPD, QVector<double>& outDeriv);
+    static ModelCurveData finishCurve(const QVector<double>& tPoints, const ModelParams& params, InversionJob& job);
+    QVector<ModelCurveData> calculateCachedCurves(const QVector<ModelParams>& paramSets, const QVector<double>& tPoints,
+                                                  const SolverConfig& config);
 
-    // 拉普拉斯空间下的复合模型函数
-    double flaplace_composite(double z, const QMap<QString, double>& p);
+    // 拉普拉斯空间下的复合模型函数 (Scalar 为 double、std::complex<double> 或 Dual<N>)
+    // Boundary 为外边界策略，Storage 为井储策略 (定义见 modelsolver01-06.cpp)
+    // Params 为 ModelParams，对偶数情形为同名字段的对偶数参数块；config 提供积分与渐近快速路径的误差限
+    template <typename Scalar, typename Boundary, typename Storage, typename Params>
+    static Scalar flaplace_composite(const Scalar& z, const Params& p, const SolverConfig& config);
 
     // 计算点源解的拉普拉斯变换值
-    double PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD, int nf, const QVector<double>& xwD, ModelType type);
+    template <typename Scalar, typename Boundary, typename Params>
+    static Scalar PWD_composite(const Scalar& z, const Scalar& fs1, const Scalar& fs2, const Params& p, const SolverConfig& config);
 
     // 数学辅助函数
-    double scaled_besseli(int v, double x);
-    double gauss15(std::function<double(double)> f, double a, double b);
-    double adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth);
-    double stefestCoefficient(int i, int N);
-    double factorial(int n);
+    // (指针形式，工作区由调用方在栈上提供，求解过程不分配内存)
+    template <typename Scalar>
+    static bool solveSymmetricToeplitz(const Scalar* firstRow, const Scalar* b, Scalar* x, int n, Scalar* work);
+    template <typename Scalar>
+    static bool solveToeplitzLU(const Scalar* firstRow, const Scalar* b, Scalar* x, int n);
 
 private:
-    ModelType m_type;       // 当前模型类型
-    bool m_highPrecision;   // 高精度计算标志
+    const ModelType m_type; // 当前模型类型 (构造后不变)
+    mutable QMutex m_configMutex; // 保护默认配置的读写
+    SolverConfig m_config;  // 默认计算配置
+    const std::unique_ptr<TypeCurveCache> m_curveCache; // 典型曲线缓存 (内部加锁，是否使用由配置决定)
 };
 
 #endif // MODELSOLVER01_06_H
@@ -0,0 +1,209 @@
+/*
+ * multistartfitter.cpp
+ * 文件作用: 多起点全局拟合实现 (属于 welltest_core 库)
+ * 功能描述:
+ * 1. 拉丁超立方抽样: 每个参数独立打乱层序号，层内均匀随机取点。
+ * 2. 起点并行: 每个起点一个任务块，起点内部的模型计算在线程池占满时自动退化为串行，不会死锁。
+ * 3. 剪枝: 各起点每次迭代后更新共享的最优平均残差平方，落后过多的起点由停止谓词终止。
+ * 4. 去重排序: 按误差排序后逐个归并到距离在容差内的已有极小值。
+ */
+
+#include "multistartfitter.h"
+#include "solverthreadpool.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+MultiStartFitter::MultiStartFitter(ModelSolver01_06* solver)
+    : m_solver(solver)
+    , m_weight(0.5)
+{
+}
+
+void MultiStartFitter::setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative)
+{
+    m_obsTime = t;
+    m_obsDeltaP = deltaP;
+    m_obsDerivative = derivative;
+}
+
+void MultiStartFitter::setWeight(double weight)
+{
+    m_weight = weight;
+}
+
+void MultiStartFitter::setOptions(const Options& options)
+{
+    m_options = options;
+}
+
+void MultiStartFitter::setRateSchedule(const RateSuperposition& rates)
+{
+    m_rates = rates;
+}
+
+void MultiStartFitter::setProgressCallback(const ProgressCallback& callback)
+{
+    m_progressCallback = callback;
+}
+
+void MultiStartFitter::setStopPredicate(const StopPredicate& predicate)
+{
+    m_stopPredicate = predicate;
+}
+
+bool MultiStartFitter::isLogSampled(const FitParameter& p)
+{
+    return p.min > 0.0 && LevenbergMarquardtFitter::isLogParameter(p.name, p.value);
+}
+
+QVector<QList<FitParameter>> MultiStartFitter::latinHypercubeStarts(const QList<FitParameter>& params, int count, unsigned int seed)
+{
+    QVector<QList<FitParameter>> starts;
+    if(count <= 0) return starts;
+    starts.fill(params, count);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<int> strata(count);
+
+    for(int j = 0; j < params.size(); ++j) {
+        const FitParameter& p = params[j];
+        if(!p.isFit || p.name == "LfD" || !(p.max > p.min)) continue;
+
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), rng);
+
+        const bool logScale = isLogSampled(p);
+        const double lo = logScale ? log10(p.min) : p.min;
+        const double hi = logScale ? log10(p.max) : p.max;
+        for(int k = 0; k < count; ++k) {
+            double x = lo + (hi - lo) * (strata[k] + unit(rng)) / count;
+            double value = logScale ? pow(10.0, x) : x;
+            starts[k][j].value = qMax(p.min, qMin(value, p.max));
+        }
+    }
+    return starts;
+}
+
+MultiStartFitter::Result MultiStartFitter::fit(const QList<FitParameter>& params, const SolverConfig& config) const
+{
+    Result result;
+    if(!m_solver || m_options.starts <= 0) return result;
+
+    // 起点: 参数表当前值 + 拉丁超立方样本
+    QVector<QList<FitParameter>> starts;
+    if(m_options.includeInitialPoint) starts.append(params);
+    for(const QList<FitParameter>& sample : latinHypercubeStarts(params, m_options.starts - starts.size(), m_options.seed))
+        starts.append(sample);
+    const int count = starts.size();
+
+    LevenbergMarquardtFitter::Options lmOptions = m_options.lmOptions;
+    lmOptions.computeFinalCurve = false;
+
+    // 共享状态: 当前最优平均残差平方、累计计算次数、已结束起点数
+    QMutex mutex;
+    double bestMse = std::numeric_limits<double>::infinity();
+    LevenbergMarquardtFitter::EvaluationStats totalStats;
+    QAtomicInt finishedStarts(0);
+
+    QVector<LevenbergMarquardtFitter::Result> fits(count);
+    QVector<bool> pruned(count, false);
+
+    SolverThreadPool::parallelFor(count, 1, [&](int begin, int end) {
+        for(int s = begin; s < end; ++s) {
+            LevenbergMarquardtFitter fitter(m_solver);
+            fitter.setObservedData(m_obsTime, m_obsDeltaP, m_obsDerivative);
+            fitter.setWeight(m_weight);
+            fitter.setOptions(lmOptions);
+            fitter.setRateSchedule(m_rates);
+
+            // 本起点的迭代状态只在本任务线程内读写
+            int iterations = 0;
+            double mse = std::numeric_limits<double>::infinity();
+            fitter.setStepCallback([&](int iteration, double currentMse) {
+                iterations = iteration;
+                mse = currentMse;
+                QMutexLocker locker(&mutex);
+                bestMse = qMin(bestMse, currentMse);
+            });
+            fitter.setStopPredicate([&]() {
+                if(m_stopPredicate && m_stopPredicate()) return true;
+                if(iterations < m_options.pruneAfterIterations) return false;
+                QMutexLocker locker(&mutex);
+                if(mse > m_options.pruneRatio * bestMse) {
+                    pruned[s] = true;
+                    return true;
+                }
+                return false;
+            });
+
+            fits[s] = fitter.fit(starts[s], config);
+
+            LevenbergMarquardtFitter::EvaluationStats snapshot;
+            {
+                QMutexLocker locker(&mutex);
+                const LevenbergMarquardtFitter::EvaluationStats& st = fits[s].stats;
+                totalStats.residualEvaluations += st.residualEvaluations;
+                totalStats.jacobianEvaluations += st.jacobianEvaluations;
+                totalStats.jacobianModelEvaluations += st.jacobianModelEvaluations;
+                totalStats.broydenUpdates += st.broydenUpdates;
+                bestMse = qMin(bestMse, fits[s].mse);
+                snapshot = totalStats;
+            }
+            const int done = finishedStarts.fetchAndAddRelaxed(1) + 1;
+            if(m_progressCallback) m_progressCallback(done * 100 / count, snapshot);
+        }
+    });
+
+    result.stats = totalStats;
+    result.stopped = m_stopPredicate && m_stopPredicate();
+
+    // 只保留正常结束的起点，按误差排序
+    QVector<int> order;
+    for(int s = 0; s < count; ++s) {
+        if(pruned[s]) ++result.prunedStarts;
+        else if(!fits[s].stopped) order.append(s);
+    }
+    result.completedStarts = order.size();
+    std::stable_sort(order.begin(), order.end(), [&fits](int a, int b) { return fits[a].mse < fits[b].mse; });
+
+    // 拟合坐标 (对数参数取 log10) 按参数范围归一化后比较
+    auto coordinate = [](const FitParameter& p, double value) {
+        return isLogSampled(p) ? log10(qMax(value, p.min)) : value;
+    };
+    auto isSameMinimum = [&](const QMap<QString, double>& a, const QMap<QString, double>& b) {
+        for(const FitParameter& p : params) {
+            if(!p.isFit || p.name == "LfD" || !(p.max > p.min)) continue;
+            double range = coordinate(p, p.max) - coordinate(p, p.min);
+            double diff = std::abs(coordinate(p, a.value(p.name)) - coordinate(p, b.value(p.name)));
+            if(diff > m_options.distinctTolerance * range) return false;
+        }
+        return true;
+    };
+
+    for(int s : order) {
+        bool merged = false;
+        for(Minimum& m : result.minima) {
+            if(isSameMinimum(m.params, fits[s].params)) {
+                ++m.hits;
+                merged = true;
+                break;
+            }
+        }
+        if(!merged) {
+            Minimum m;
+            m.params = fits[s].params;
+            m.mse = fits[s].mse;
+            m.startIndex = s;
+            m.hits = 1;
+            result.minima.append(m);
+        }
+    }
+    return result;
+}
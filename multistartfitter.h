@@ -0,0 +1,83 @@
+/*
+ * multistartfitter.h
+ * 文件作用: 多起点全局拟合头文件 (属于 welltest_core 库，不依赖界面)
+ * 功能描述:
+ * 1. 在各拟合参数的上下限内以拉丁超立方抽样生成 K 个起点 (对数参数在 log10 空间抽样)，
+ *    可选把参数表当前值作为第一个起点。
+ * 2. 各起点独立运行 Levenberg-Marquardt 拟合，通过 SolverThreadPool 并行执行，总耗时接近单次拟合。
+ * 3. 迭代若干次后平均残差平方仍远高于当前最优值的起点提前终止 (剪枝)，把计算留给有希望的起点。
+ * 4. 收敛结果按拟合坐标下的距离合并为互不相同的极小值，按误差由小到大排序输出。
+ */
+
+#ifndef MULTISTARTFITTER_H
+#define MULTISTARTFITTER_H
+
+#include "levenbergmarquardtfitter.h"
+
+class MultiStartFitter
+{
+public:
+    struct Options {
+        int starts = 8;                     // 起点个数 K
+        bool includeInitialPoint = true;    // 第一个起点使用参数表当前值
+        unsigned int seed = 20240601;       // 拉丁超立方抽样随机种子 (固定种子使结果可复现)
+        int pruneAfterIterations = 3;       // 迭代次数达到该值后才参与剪枝判断
+        double pruneRatio = 10.0;           // 平均残差平方超过当前最优值的该倍数时终止该起点
+        double distinctTolerance = 0.05;    // 两个解在各参数 (按上下限范围归一化的拟合坐标) 上的差均小于该值时视为同一极小值
+        LevenbergMarquardtFitter::Options lmOptions;    // 单个起点的 LM 迭代选项
+    };
+
+    // 一个互不相同的极小值
+    struct Minimum {
+        QMap<QString, double> params;   // 该极小值的参数 (取落入该极小值的起点中误差最小者)
+        double mse = 0.0;               // 平均残差平方
+        int startIndex = 0;             // 取得该参数的起点序号
+        int hits = 0;                   // 收敛到该极小值的起点个数
+    };
+
+    struct Result {
+        QVector<Minimum> minima;        // 互不相同的极小值，按 mse 由小到大排序
+        int completedStarts = 0;        // 正常结束的起点个数
+        int prunedStarts = 0;           // 被剪枝终止的起点个数
+        bool stopped = false;           // 是否因停止请求提前结束
+        LevenbergMarquardtFitter::EvaluationStats stats;    // 全部起点的模型计算次数之和
+    };
+
+    // 进度回调: percent 为已结束起点的比例；可能在线程池的任意线程中调用
+    using ProgressCallback = std::function<void(int percent, const LevenbergMarquardtFitter::EvaluationStats& stats)>;
+    using StopPredicate = LevenbergMarquardtFitter::StopPredicate;
+
+    explicit MultiStartFitter(ModelSolver01_06* solver);
+
+    void setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& derivative);
+    void setWeight(double weight);
+    void setOptions(const Options& options);
+    // 变产量史 (为空时按恒定产量计算)，原样交给各起点的 LM 拟合器
+    void setRateSchedule(const RateSuperposition& rates);
+    void setProgressCallback(const ProgressCallback& callback);
+    void setStopPredicate(const StopPredicate& predicate);
+
+    // 执行多起点拟合 (config 按次传入，迭代使用其快速模式)
+    Result fit(const QList<FitParameter>& params, const SolverConfig& config) const;
+
+    // 拉丁超立方起点: 每个拟合参数的范围等分为 count 层，每层恰好抽到一次；非拟合参数保持原值
+    static QVector<QList<FitParameter>> latinHypercubeStarts(const QList<FitParameter>& params, int count, unsigned int seed);
+
+    // 参数是否在 log10 空间抽样与比较 (与 LM 的对数更新规则一致，且下限为正；全局优化器共用)
+    static bool isLogSampled(const FitParameter& p);
+
+private:
+
+    ModelSolver01_06* m_solver;
+    QVector<double> m_obsTime;
+    QVector<double> m_obsDeltaP;
+    QVector<double> m_obsDerivative;
+    double m_weight;
+    Options m_options;
+    RateSuperposition m_rates;
+
+    ProgressCallback m_progressCallback;
+    StopPredicate m_stopPredicate;
+};
+
+#endif // MULTISTARTFITTER_H
@@ -5,6 +5,8 @@
  * 1. 定义了计算结果结构体 PressureDerivativeResult，兼容旧代码接口。
  * 2. 定义了计算配置结构体 PressureDerivativeConfig，包含试井类型和初始压力参数。
  * 3. 声明了计算核心类，支持自动计算压差和Bourdet导数。
+ * 4. 头文件只依赖 QtCore：静态导数算法属于 welltest_core 库，读写 QStandardItemModel 的成员函数
+ *    实现在 pressurederivativecalculator_model.cpp 中，只由界面程序编译。
  */
 
 #ifndef PRESSUREDERIVATIVECALCULATOR_H
@@ -13,7 +15,9 @@
 #include <QObject>
 #include <QString>
 #include <QVector>
-#include <QStandardItemModel>
+#include <cmath>
+
+class QStandardItemModel;
 
 // 压力导数计算结果结构
 struct PressureDerivativeResult {
@@ -119,6 +123,15 @@ public:
                                                       const QVector<double>& pressureDropData,
                                                       double lSpacing);
 
+    /**
+     * @brief 不取绝对值的 Bourdet 导数 (与 calculateBourdetDerivative 选点和加权完全相同)
+     * 结果对压差是线性的，压差可以是对偶数 (dualnumber.h)，用于理论曲线导数对模型参数的灵敏度
+     */
+    template <typename T>
+    static QVector<T> calculateSignedBourdetDerivative(const QVector<double>& timeData,
+                                                       const QVector<T>& pressureDropData,
+                                                       double lSpacing);
+
 signals:
     void progressUpdated(int progress, const QString& message);
     void calculationCompleted(const PressureDerivativeResult& result);
@@ -127,7 +140,8 @@ private:
     // 内部静态辅助函数
     static int findLeftPoint(const QVector<double>& timeData, int currentIndex, double lSpacing);
     static int findRightPoint(const QVector<double>& timeData, int currentIndex, double lSpacing);
-    static double calculateDerivativeValue(double t1, double t2, double p1, double p2);
+    template <typename T>
+    static T derivativeValue(double t1, double t2, const T& p1, const T& p2);
 
     int findPressureColumn(QStandardItemModel* model);
     int findTimeColumn(QStandardItemModel* model);
@@ -135,4 +149,63 @@ private:
     QString formatValue(double value, int precision = 6);
 };
 
+// 两点对数差分 (p1 - p2) / (ln t1 - ln t2)
+template <typename T>
+T PressureDerivativeCalculator::derivativeValue(double t1, double t2, const T& p1, const T& p2)
+{
+    if (t1 <= 0 || t2 <= 0) return T(0.0);
+    double deltaLnT = std::log(t1) - std::log(t2);
+    if (std::abs(deltaLnT) < 1e-10) return T(0.0);
+    return (p1 - p2) / deltaLnT;
+}
+
+template <typename T>
+QVector<T> PressureDerivativeCalculator::calculateSignedBourdetDerivative(const QVector<double>& timeData,
+                                                                         const QVector<T>& pressureDropData,
+                                                                         double lSpacing)
+{
+    QVector<T> derivativeData;
+    int n = timeData.size();
+    derivativeData.reserve(n);
+
+    for (int i = 0; i < n; ++i) {
+        T derivative(0.0);
+        double ti = timeData[i];
+        const T& pi = pressureDropData[i];
+
+        // 左侧点 j：ln(ti) - ln(tj) ≥ L；右侧点 k：ln(tk) - ln(ti) ≥ L
+        int leftIndex = findLeftPoint(timeData, i, lSpacing);
+        int rightIndex = findRightPoint(timeData, i, lSpacing);
+
+        if (leftIndex >= 0 && rightIndex >= 0) {
+            // 1. 左右两点加权平均 (Bourdet Standard)
+            double tj = timeData[leftIndex];
+            double tk = timeData[rightIndex];
+            double deltaXL = std::log(ti) - std::log(tj);
+            double deltaXR = std::log(tk) - std::log(ti);
+
+            T mL = derivativeValue(ti, tj, pi, pressureDropData[leftIndex]);
+            T mR = derivativeValue(tk, ti, pressureDropData[rightIndex], pi);
+            if (deltaXL + deltaXR > 1e-12) {
+                derivative = (mL * deltaXR + mR * deltaXL) / (deltaXL + deltaXR);
+            }
+        } else if (leftIndex >= 0) {
+            // 2. 只有左侧点 (曲线末端)
+            derivative = derivativeValue(ti, timeData[leftIndex], pi, pressureDropData[leftIndex]);
+        } else if (rightIndex >= 0) {
+            // 3. 只有右侧点 (曲线开端)
+            derivative = derivativeValue(timeData[rightIndex], ti, pressureDropData[rightIndex], pi);
+        } else if (i > 0) {
+            // 4. L-Spacing 范围内点不足：相邻点差分保底
+            derivative = derivativeValue(ti, timeData[i - 1], pi, pressureDropData[i - 1]);
+        } else if (i < n - 1) {
+            derivative = derivativeValue(timeData[i + 1], ti, pressureDropData[i + 1], pi);
+        }
+
+        derivativeData.append(derivative);
+    }
+
+    return derivativeData;
+}
+
 #endif // PRESSUREDERIVATIVECALCULATOR_H
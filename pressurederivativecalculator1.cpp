@@ -1,93 +1,21 @@
 /*
  * pressurederivativecalculator1.cpp
- * 文件作用：高级压力导数计算器实现文件
- * 功能描述：实现导数计算后的平滑处理逻辑
+ * 文件作用：高级压力导数计算器实现文件 (计算核心部分，属于 welltest_core 库)
+ * 功能描述：实现导数计算后的平滑处理与对数等间距重采样逻辑；读写表格数据模型的接口见 pressurederivativecalculator1_model.cpp
  */
 
 #include "pressurederivativecalculator1.h"
 #include <QtMath>
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 PressureDerivativeCalculator1::PressureDerivativeCalculator1(QObject *parent)
     : QObject(parent)
 {
 }
 
-PressureDerivativeResult PressureDerivativeCalculator1::calculateSmoothedDerivative(
-    QStandardItemModel* model, const PressureDerivativeConfig& config, int smoothFactor)
-{
-    // 1. 先使用基础计算器计算标准的Bourdet导数
-    // 注意：这里我们借用基础计算器的逻辑，但在写入模型前拦截数据进行平滑
-    // 为了简化，我们手动执行提取数据、计算导数、平滑、写入的流程
-
-    PressureDerivativeResult result;
-    result.success = false;
-
-    if (!model) {
-        result.errorMessage = "数据模型为空";
-        return result;
-    }
-
-    // 复用基础类的列检测和数据读取逻辑（此处简化为直接读取，实际项目中可提取基础类函数为public static）
-    int rows = model->rowCount();
-    QVector<double> timeData;
-    QVector<double> pressureData;
-    timeData.reserve(rows);
-    pressureData.reserve(rows);
-
-    for(int i=0; i<rows; ++i) {
-        QStandardItem* tItem = model->item(i, config.timeColumnIndex);
-        QStandardItem* pItem = model->item(i, config.pressureColumnIndex);
-        if(tItem && pItem) {
-            bool okT, okP;
-            double t = tItem->text().toDouble(&okT);
-            double p = pItem->text().toDouble(&okP);
-            if(okT && okP) {
-                timeData.append(t);
-                pressureData.append(p);
-            }
-        }
-    }
-
-    if(timeData.isEmpty()) {
-        result.errorMessage = "未能读取有效数据";
-        return result;
-    }
-
-    // 处理时间偏移
-    double offset = config.autoTimeOffset ? (timeData.first() <= 0 ? 0.0001 : 0.0) : config.timeOffset;
-    QVector<double> adjustedTime;
-    for(double t : timeData) adjustedTime.append(t + offset);
-
-    // 计算压降
-    double pInitial = pressureData.first();
-    QVector<double> dp;
-    for(double p : pressureData) dp.append(pInitial - p);
-
-    // 计算Bourdet导数
-    QVector<double> derivative = PressureDerivativeCalculator::calculateBourdetDerivative(adjustedTime, dp, config.lSpacing);
-
-    // 2. 执行平滑处理
-    QVector<double> smoothedDeriv = smoothData(derivative, smoothFactor);
-
-    // 3. 写入数据模型
-    int newCol = model->columnCount();
-    model->insertColumn(newCol);
-    QString header = QString("平滑导数(L=%1, S=%2)").arg(config.lSpacing).arg(smoothFactor);
-    model->setHorizontalHeaderItem(newCol, new QStandardItem(header));
-
-    for(int i=0; i<smoothedDeriv.size() && i<rows; ++i) {
-        model->setItem(i, newCol, new QStandardItem(QString::number(smoothedDeriv[i], 'g', 6)));
-    }
-
-    result.success = true;
-    result.addedColumnIndex = newCol;
-    result.columnName = header;
-    result.processedRows = smoothedDeriv.size();
-
-    return result;
-}
-
 QVector<double> PressureDerivativeCalculator1::smoothData(const QVector<double>& data, int span)
 {
     int n = data.size();
@@ -120,3 +48,77 @@ QVector<double> PressureDerivativeCalculator1::smoothData(const QVector<double>&
     }
     return result;
 }
+
+void PressureDerivativeCalculator1::resampleLogUniform(const QVector<double>& time, const QVector<double>& deltaP, const QVector<double>& derivative,
+                                                      int pointsPerCycle, bool useMedian,
+                                                      QVector<double>& outTime, QVector<double>& outDeltaP, QVector<double>& outDerivative)
+{
+    outTime.clear();
+    outDeltaP.clear();
+    outDerivative.clear();
+
+    // 有效点按时间排序 (实测数据通常已递增，stable_sort 保持等时刻点的原顺序)
+    int n = qMin(time.size(), deltaP.size());
+    QVector<int> order;
+    order.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        if (time[i] > 0) order.append(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&time](int a, int b) { return time[a] < time[b]; });
+
+    auto derivAt = [&derivative](int i) { return i < derivative.size() ? derivative[i] : 0.0; };
+
+    if (pointsPerCycle <= 0) {
+        for (int i : order) {
+            outTime.append(time[i]);
+            outDeltaP.append(deltaP[i]);
+            outDerivative.append(derivAt(i));
+        }
+        return;
+    }
+
+    auto median = [](QVector<double>& v) {
+        const int mid = v.size() / 2;
+        std::nth_element(v.begin(), v.begin() + mid, v.end());
+        double m = v[mid];
+        if (v.size() % 2 == 0) {
+            // 偶数个点取中间两数的平均
+            m = 0.5 * (m + *std::max_element(v.begin(), v.begin() + mid));
+        }
+        return m;
+    };
+    auto mean = [](const QVector<double>& v) {
+        return std::accumulate(v.begin(), v.end(), 0.0) / v.size();
+    };
+
+    QVector<double> binT, binP, binD;
+    auto flush = [&]() {
+        if (binT.isEmpty()) return;
+        if (useMedian) {
+            outTime.append(median(binT));
+            outDeltaP.append(median(binP));
+            outDerivative.append(median(binD));
+        } else {
+            double logSum = 0.0;
+            for (double t : binT) logSum += log10(t);
+            outTime.append(qPow(10.0, logSum / binT.size()));
+            outDeltaP.append(mean(binP));
+            outDerivative.append(mean(binD));
+        }
+        binT.clear();
+        binP.clear();
+        binD.clear();
+    };
+
+    // 箱序号 floor(log10(t)·pointsPerCycle)，微小偏移避免整周期时间点因舍入落入前一个箱
+    long long currentBin = 0;
+    for (int i : order) {
+        long long bin = static_cast<long long>(std::floor(log10(time[i]) * pointsPerCycle + 1e-9));
+        if (!binT.isEmpty() && bin != currentBin) flush();
+        currentBin = bin;
+        binT.append(time[i]);
+        binP.append(deltaP[i]);
+        binD.append(derivAt(i));
+    }
+    flush();
+}
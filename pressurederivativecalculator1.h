@@ -4,7 +4,8 @@
  * 功能描述：
  * 1. 继承或复用原有导数计算逻辑
  * 2. 新增平滑处理功能（类似Matlab smooth函数）
- * 3. 提供静态计算接口
+ * 3. 提供静态计算接口 (smoothData 属于 welltest_core 库，表格模型接口由界面程序编译)
+ * 4. 新增对数等间距重采样: 按每对数周期固定点数分箱取中位数或平均值，减少拟合用数据点
  */
 
 #ifndef PRESSUREDERIVATIVECALCULATOR1_H
@@ -39,6 +40,22 @@ public:
      */
     static QVector<double> smoothData(const QVector<double>& data, int span);
 
+    /**
+     * @brief 对数等间距重采样 (拟合数据精简)
+     * 时间轴按 log10 划分为每周期 pointsPerCycle 个箱 (箱边界与整数周期对齐)，
+     * 每个非空箱输出一个点: 中位数模式取各列中位数，平均值模式取时间几何平均、压差与导数算术平均。
+     * 时间非正的点被丢弃；derivative 长度不足时缺失部分按 0 处理。
+     * @param time 原始时间
+     * @param deltaP 原始压差
+     * @param derivative 原始压力导数
+     * @param pointsPerCycle 每个对数周期的点数 (<= 0 时原样返回有效点)
+     * @param useMedian true 取中位数，false 取平均值
+     * @param outTime/outDeltaP/outDerivative 重采样结果 (按时间递增)
+     */
+    static void resampleLogUniform(const QVector<double>& time, const QVector<double>& deltaP, const QVector<double>& derivative,
+                                   int pointsPerCycle, bool useMedian,
+                                   QVector<double>& outTime, QVector<double>& outDeltaP, QVector<double>& outDerivative);
+
 signals:
     void progressUpdated(int progress, const QString& message);
     void calculationCompleted(const PressureDerivativeResult& result);
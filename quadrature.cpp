@@ -0,0 +1,34 @@
+/*
+ * quadrature.cpp
+ * 文件作用: 固定节点 Gauss-Kronrod 数值积分实现
+ * 功能描述:
+ * 1. 积分模板函数定义在 quadrature.h 中，本文件只提供常数表定义与计算次数计数器。
+ * 2. 计数器为原子变量，每次自适应积分结束时一次性累加，避免逐节点的原子操作开销。
+ */
+
+#include "quadrature.h"
+
+#include <QAtomicInteger>
+
+constexpr double Quadrature::kXgk[8];
+constexpr double Quadrature::kWgk[8];
+constexpr double Quadrature::kWg[4];
+
+namespace {
+QAtomicInteger<qint64> g_evaluations(0);
+}
+
+qint64 Quadrature::evaluationCount()
+{
+    return g_evaluations.loadRelaxed();
+}
+
+void Quadrature::resetEvaluationCount()
+{
+    g_evaluations.storeRelaxed(0);
+}
+
+void Quadrature::addEvaluations(qint64 count)
+{
+    g_evaluations.fetchAndAddRelaxed(count);
+}
@@ -0,0 +1,160 @@
+/*
+ * ratesuperposition.cpp
+ * 文件作用: 变产量 (分段恒定产量) 叠加计算实现
+ * 功能描述:
+ * 1. 产量史的整理 (排序、去重、合并产量不变的相邻段) 与产量图数据的解释。
+ * 2. 单位产量响应的一次性计算，以及全部 Δt 的批量插值与叠加。
+ */
+
+#include "ratesuperposition.h"
+
+#include <cmath>
+#include <algorithm>
+
+RateSuperposition::RateSuperposition()
+{
+}
+
+RateSuperposition::RateSuperposition(const QVector<Step>& steps)
+{
+    QVector<Step> sorted;
+    for (const Step& step : steps) {
+        if (std::isfinite(step.startTime) && std::isfinite(step.rate)) sorted.append(step);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Step& a, const Step& b) {
+        return a.startTime < b.startTime;
+    });
+
+    double previousRate = 0.0;
+    for (const Step& step : sorted) {
+        if (!m_steps.isEmpty() && m_steps.last().startTime == step.startTime) {
+            // 同一时刻的多个产量取最后一个
+            m_steps.removeLast();
+            previousRate = m_steps.isEmpty() ? 0.0 : m_steps.last().rate;
+        }
+        if (step.rate == previousRate) continue;
+        m_steps.append(step);
+        previousRate = step.rate;
+    }
+}
+
+RateSuperposition RateSuperposition::fromStepData(const QVector<double>& times, const QVector<double>& rates)
+{
+    QVector<Step> steps;
+    const int n = std::min(times.size(), rates.size());
+    if (n == 0) return RateSuperposition();
+
+    bool isAbsoluteTime = n > 1;
+    for (int i = 0; i + 1 < n; ++i) {
+        if (times[i + 1] <= times[i]) {
+            isAbsoluteTime = false;
+            break;
+        }
+    }
+
+    if (isAbsoluteTime) {
+        for (int i = 0; i < n; ++i) steps.append({ times[i], rates[i] });
+    } else {
+        // 各段持续时间: 第 i 段从累计时间开始
+        double tCum = 0.0;
+        for (int i = 0; i < n; ++i) {
+            steps.append({ tCum, rates[i] });
+            tCum += times[i];
+        }
+    }
+    return RateSuperposition(steps);
+}
+
+RateSuperposition RateSuperposition::fromRateSamples(const QVector<double>& times, const QVector<double>& rates)
+{
+    QVector<Step> steps;
+    const int n = std::min(times.size(), rates.size());
+    for (int i = 0; i < n; ++i) {
+        if (i == 0) steps.append({ 0.0, rates[i] });
+        else if (rates[i] != rates[i - 1]) steps.append({ times[i - 1], rates[i] });
+    }
+    return RateSuperposition(steps);
+}
+
+const QVector<RateSuperposition::Step>& RateSuperposition::steps() const
+{
+    return m_steps;
+}
+
+bool RateSuperposition::isEmpty() const
+{
+    return m_steps.isEmpty();
+}
+
+bool RateSuperposition::elapsedRange(const QVector<double>& times, double& dtMin, double& dtMax) const
+{
+    dtMin = 0.0;
+    dtMax = 0.0;
+    for (double t : times) {
+        for (const Step& step : m_steps) {
+            const double dt = t - step.startTime;
+            if (!(dt > 0.0)) break;
+            if (dtMin == 0.0 || dt < dtMin) dtMin = dt;
+            if (dt > dtMax) dtMax = dt;
+        }
+    }
+    return dtMax > 0.0;
+}
+
+// 叠加: 先收集全部 (时间点, 流动段) 的正 Δt，一次插值后按产量增量累加
+ModelCurveData RateSuperposition::superpose(const ModelCurveData& unitResponse, const QVector<double>& times) const
+{
+    QVector<double> finalP(times.size(), 0.0), finalDP(times.size(), 0.0);
+
+    QVector<double> elapsed;
+    QVector<int> owner;
+    QVector<double> deltaRate;
+    for (int i = 0; i < times.size(); ++i) {
+        double previousRate = 0.0;
+        for (const Step& step : m_steps) {
+            const double dt = times[i] - step.startTime;
+            if (!(dt > 0.0)) break;
+            elapsed.append(dt);
+            owner.append(i);
+            deltaRate.append(step.rate - previousRate);
+            previousRate = step.rate;
+        }
+    }
+    if (elapsed.isEmpty()) return std::make_tuple(times, finalP, finalDP);
+
+    const ModelCurveData unit = ModelSolver01_06::interpolateCurve(unitResponse, elapsed);
+    const QVector<double>& unitP = std::get<1>(unit);
+    const QVector<double>& unitD = std::get<2>(unit);
+    for (int k = 0; k < elapsed.size(); ++k) {
+        const int i = owner[k];
+        finalP[i] += deltaRate[k] * unitP[k];
+        finalDP[i] += deltaRate[k] * unitD[k] * (times[i] / elapsed[k]);
+    }
+    return std::make_tuple(times, finalP, finalDP);
+}
+
+ModelCurveData RateSuperposition::calculate(ModelSolver01_06& solver, const ModelParams& params, const QVector<double>& times,
+                                            const SolverConfig& config, double tolerance, int maxPoints) const
+{
+    double dtMin = 0.0, dtMax = 0.0;
+    if (!elapsedRange(times, dtMin, dtMax)) {
+        return std::make_tuple(times, QVector<double>(times.size(), 0.0), QVector<double>(times.size(), 0.0));
+    }
+    // 只有一个 Δt 时自适应网格区间退化，两端略作外扩
+    if (!(dtMax > dtMin)) {
+        dtMin *= 0.5;
+        dtMax *= 2.0;
+    }
+
+    const ModelCurveData unit = solver.calculateAdaptiveCurve(unitRateParams(params), dtMin, dtMax,
+                                                              tolerance, maxPoints, config);
+    return superpose(unit, times);
+}
+
+ModelParams RateSuperposition::unitRateParams(const ModelParams& params)
+{
+    ModelParams unit = params;
+    unit.q = 1.0;
+    unit.pCoeff = ModelSolver01_06::pressureCoefficient(unit);
+    return unit;
+}
@@ -0,0 +1,61 @@
+/*
+ * ratesuperposition.h
+ * 文件作用: 变产量 (分段恒定产量) 叠加计算头文件
+ * 功能描述:
+ * 1. 模型求解器只给出恒定产量 q 下的压差。实际测试存在多个流动段，
+ *    按叠加原理 Δp(t) = Σ (q_i - q_{i-1})·Δp_u(t - t_i)，其中 Δp_u 为单位产量响应。
+ * 2. 单位产量响应只在一个共享的对数时间网格上计算一次 (自适应网格，见 calculateAdaptiveCurve)，
+ *    全部 (时间点 × 产量变化) 组合的 Δt 一次性在该曲线上做单调三次插值，
+ *    多流动段历史的计算量约等于一条理论曲线，与产量变化次数基本无关。
+ * 3. 导数输出为对数时间导数 t·dΔp/dt = Σ Δq_i·t/(t - t_i)·d_u(t - t_i)，d_u 为单位产量响应的对数时间导数。
+ * 4. 产量史可直接由双坐标 (压力 + 产量) 图的产量数据构造，时间列既可为各段起始时刻，也可为各段持续时间；
+ *    也可由观测数据中逐点记录的产量列构造 (拟合界面)。
+ * 5. 压敏模型 (gamaD ≠ 0) 的控制方程非线性，此时叠加结果为近似值。
+ */
+
+#ifndef RATESUPERPOSITION_H
+#define RATESUPERPOSITION_H
+
+#include <QVector>
+#include "modelsolver01-06.h"
+
+class RateSuperposition
+{
+public:
+    // 流动段: 自 startTime 起以恒定产量 rate 生产 (startTime 与理论曲线时间同单位，第一段之前产量为 0)
+    struct Step {
+        double startTime = 0.0;
+        double rate = 0.0;
+    };
+
+    RateSuperposition();
+    // 流动段按起始时刻排序，相同起始时刻只保留最后一段，产量不变的相邻段合并
+    explicit RateSuperposition(const QVector<Step>& steps);
+
+    // 由产量图数据构造 (与 WT_PlottingWidget::drawStackedPlot 的阶梯图解释一致):
+    // times 严格递增时视为各段起始时刻，否则视为各段持续时间 (第一段从 0 开始)
+    static RateSuperposition fromStepData(const QVector<double>& times, const QVector<double>& rates);
+    // 由逐点记录的产量构造: 第一个点的产量自 0 时刻起生效，产量改变的点视为自上一观测时刻起进入新流动段
+    static RateSuperposition fromRateSamples(const QVector<double>& times, const QVector<double>& rates);
+
+    const QVector<Step>& steps() const;
+    bool isEmpty() const;
+
+    // 对给定时间点叠加所需的单位产量响应时间范围 [dtMin, dtMax]，没有任何正的 Δt 时返回 false
+    bool elapsedRange(const QVector<double>& times, double& dtMin, double& dtMax) const;
+
+    // 由单位产量响应曲线 (时间需覆盖 elapsedRange) 叠加得到各时间点的压差与对数时间导数
+    ModelCurveData superpose(const ModelCurveData& unitResponse, const QVector<double>& times) const;
+
+    // 完整流程: 以 q = 1 计算单位产量响应 (自适应网格，对数插值误差限 tolerance)，再叠加
+    ModelCurveData calculate(ModelSolver01_06& solver, const ModelParams& params, const QVector<double>& times,
+                             const SolverConfig& config, double tolerance = 1e-4, int maxPoints = 2000) const;
+
+    // 单位产量参数块 (q = 1，压力换算系数随之更新)
+    static ModelParams unitRateParams(const ModelParams& params);
+
+private:
+    QVector<Step> m_steps;
+};
+
+#endif // RATESUPERPOSITION_H
@@ -0,0 +1,66 @@
+/*
+ * solverthreadpool.cpp
+ * 文件作用: 模型求解器共享线程池实现
+ * 功能描述:
+ * 1. 懒加载创建共享 QThreadPool。
+ * 2. parallelFor 采用原子计数器分块领取任务，调用线程与工作线程共同消耗任务块，
+ *    全部任务块完成后返回。
+ */
+
+#include "solverthreadpool.h"
+
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QThread>
+#include <algorithm>
+
+QThreadPool* SolverThreadPool::instance()
+{
+    static QThreadPool pool;
+    return &pool;
+}
+
+void SolverThreadPool::parallelFor(int count, int chunkSize, const std::function<void(int, int)>& body)
+{
+    if (count <= 0) return;
+
+    QThreadPool* pool = instance();
+    const int threads = std::max(1, pool->maxThreadCount());
+
+    // 块大小: 默认每个线程约 8 块，兼顾负载均衡与调度开销
+    if (chunkSize <= 0) chunkSize = std::max(1, count / (threads * 8));
+    const int numChunks = (count + chunkSize - 1) / chunkSize;
+
+    // 串行路径: 单线程或只有一个任务块
+    if (threads <= 1 || numChunks <= 1) {
+        body(0, count);
+        return;
+    }
+
+    QAtomicInt next(0);
+    QSemaphore finished(0);
+
+    auto drain = [&]() {
+        for (;;) {
+            const int begin = next.fetchAndAddRelaxed(chunkSize);
+            if (begin >= count) break;
+            body(begin, std::min(begin + chunkSize, count));
+        }
+    };
+
+    // 只在有空闲线程时启动工作线程 (tryStart)，线程池被占满时由调用线程独立完成全部任务，
+    // 从而在拟合线程等嵌套调用场景下也不会死锁
+    const int wanted = std::min(threads, numChunks) - 1;
+    int started = 0;
+    for (int i = 0; i < wanted; ++i) {
+        bool ok = pool->tryStart([&]() {
+            drain();
+            finished.release();
+        });
+        if (!ok) break;
+        ++started;
+    }
+
+    drain();
+    finished.acquire(started);
+}
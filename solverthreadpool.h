@@ -0,0 +1,29 @@
+/*
+ * solverthreadpool.h
+ * 文件作用: 模型求解器共享线程池头文件
+ * 功能描述:
+ * 1. 为模型计算提供一个独立于 QThreadPool::globalInstance() 的共享线程池，
+ *    避免与 QtConcurrent 拟合线程争用同一个池而相互阻塞。
+ * 2. 提供分块 parallelFor：工作线程通过原子计数器领取区间块 (work-stealing)，
+ *    调用线程本身也参与计算；线程池繁忙时自动退化为调用线程串行执行，不会死锁。
+ * 3. 每个下标只由一个线程计算，结果写入各自位置，因此与串行计算逐位一致。
+ */
+
+#ifndef SOLVERTHREADPOOL_H
+#define SOLVERTHREADPOOL_H
+
+#include <QThreadPool>
+#include <functional>
+
+class SolverThreadPool
+{
+public:
+    // 共享线程池实例 (线程数默认等于 CPU 逻辑核数)
+    static QThreadPool* instance();
+
+    // 对区间 [0, count) 分块并行执行 body(begin, end)
+    // chunkSize <= 0 时按线程数自动选择块大小
+    static void parallelFor(int count, int chunkSize, const std::function<void(int, int)>& body);
+};
+
+#endif // SOLVERTHREADPOOL_H
@@ -0,0 +1,50 @@
+/*
+ * stehfestweights.cpp
+ * 文件作用: Stehfest 数值反演权重系数表实现
+ * 功能描述:
+ * 1. 将 N = 4 ~ 20 的查询分派到编译期生成的常量表。
+ * 2. 其他 N 值在首次使用时以扩展精度计算一次并缓存，互斥锁保证多线程安全。
+ */
+
+#include "stehfestweights.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <map>
+#include <vector>
+
+// 查询 N 项权重表
+const double* StehfestWeights::weights(int N)
+{
+    using StehfestDetail::Table;
+    switch (N) {
+    case 4:  return Table<4>::values.data();
+    case 6:  return Table<6>::values.data();
+    case 8:  return Table<8>::values.data();
+    case 10: return Table<10>::values.data();
+    case 12: return Table<12>::values.data();
+    case 14: return Table<14>::values.data();
+    case 16: return Table<16>::values.data();
+    case 18: return Table<18>::values.data();
+    case 20: return Table<20>::values.data();
+    default: return lazyWeights(N);
+    }
+}
+
+// 运行时计算并缓存其他 N 值的权重表
+const double* StehfestWeights::lazyWeights(int N)
+{
+    static QMutex mutex;
+    // 使用 std::map + std::vector 保存：插入新表不会移动已有表的存储，返回的指针长期有效
+    static std::map<int, std::vector<double>> cache;
+
+    QMutexLocker locker(&mutex);
+    auto it = cache.find(N);
+    if (it != cache.end()) return it->second.data();
+
+    std::vector<double> table(N > 0 ? N : 0);
+    for (int i = 1; i <= N; ++i) {
+        table[i - 1] = static_cast<double>(StehfestDetail::weight(i, N));
+    }
+    return cache.emplace(N, std::move(table)).first->second.data();
+}
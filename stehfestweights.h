@@ -0,0 +1,85 @@
+/*
+ * stehfestweights.h
+ * 文件作用: Stehfest 数值反演权重系数表头文件
+ * 功能描述:
+ * 1. 以 constexpr 方式在编译期生成 N = 4, 6, ..., 20 的 Stehfest 权重表，
+ *    计算过程使用 long double 扩展精度，避免阶乘连乘在双精度下的精度损失。
+ * 2. 对其他 N 值 (如 N > 20) 提供惰性计算并缓存的权重表，线程安全。
+ * 3. 反演循环中每一项只需一次查表，不再重复计算阶乘。
+ */
+
+#ifndef STEHFESTWEIGHTS_H
+#define STEHFESTWEIGHTS_H
+
+#include <array>
+
+namespace StehfestDetail {
+
+// 编译期阶乘 (扩展精度)
+constexpr long double factorial(int n)
+{
+    long double r = 1.0L;
+    for (int i = 2; i <= n; ++i) r *= i;
+    return r;
+}
+
+// 编译期整数次幂 k^e
+constexpr long double integerPower(int k, int e)
+{
+    long double r = 1.0L;
+    for (int i = 0; i < e; ++i) r *= k;
+    return r;
+}
+
+// 第 i 项 (1 <= i <= N) Stehfest 权重 V_i
+// V_i = (-1)^(i+N/2) * Σ_{k=[(i+1)/2]}^{min(i,N/2)} k^(N/2) (2k)! / ((N/2-k)! k! (k-1)! (i-k)! (2k-i)!)
+constexpr long double weight(int i, int N)
+{
+    const int half = N / 2;
+    const int k1 = (i + 1) / 2;
+    const int k2 = (i < half) ? i : half;
+    long double s = 0.0L;
+    for (int k = k1; k <= k2; ++k) {
+        long double num = integerPower(k, half) * factorial(2 * k);
+        long double den = factorial(half - k) * factorial(k) * factorial(k - 1)
+                          * factorial(i - k) * factorial(2 * k - i);
+        s += num / den;
+    }
+    return ((i + half) % 2 == 0) ? s : -s;
+}
+
+// 生成 N 项权重表 (下标 0 对应 V_1)
+template <int N>
+constexpr std::array<double, N> makeTable()
+{
+    std::array<double, N> t{};
+    for (int i = 1; i <= N; ++i) t[i - 1] = static_cast<double>(weight(i, N));
+    return t;
+}
+
+// 编译期权重表
+template <int N>
+struct Table
+{
+    static constexpr std::array<double, N> values = makeTable<N>();
+};
+
+} // namespace StehfestDetail
+
+class StehfestWeights
+{
+public:
+    // 编译期预生成权重表的 N 范围 (仅偶数)
+    static constexpr int kMinTabulatedN = 4;
+    static constexpr int kMaxTabulatedN = 20;
+
+    // 获取 N 项 Stehfest 权重 V_1..V_N (返回指针下标 0..N-1)
+    // N 必须为正偶数；返回的指针在程序生命周期内一直有效
+    static const double* weights(int N);
+
+private:
+    // 非预生成 N 值的运行时计算 (扩展精度)
+    static const double* lazyWeights(int N);
+};
+
+#endif // STEHFESTWEIGHTS_H
@@ -0,0 +1,191 @@
+/*
+ * typecurvecache.cpp
+ * 文件作用: 无因次典型曲线缓存实现
+ * 功能描述:
+ * 1. 对齐网格生成、自然三次样条建立与插值。
+ * 2. 基于 QCache 的 LRU 存取与命中统计 (互斥锁保护)。
+ */
+
+#include "typecurvecache.h"
+
+#include <QMutexLocker>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+// 网格两端外扩的十倍程数
+const int kMarginDecades = 1;
+
+// 均匀网格 (步长为 1) 上的自然三次样条二阶导数，Thomas 算法求解三对角方程组
+QVector<double> splineSecondDerivatives(const QVector<double>& y)
+{
+    const int n = y.size();
+    QVector<double> m(n, 0.0);
+    if (n < 3) return m;
+
+    // 内部方程: m[i-1] + 4 m[i] + m[i+1] = 6 (y[i+1] - 2 y[i] + y[i-1])，两端 m = 0
+    QVector<double> c(n, 0.0), d(n, 0.0);
+    for (int i = 1; i < n - 1; ++i) {
+        const double rhs = 6.0 * (y[i + 1] - 2.0 * y[i] + y[i - 1]);
+        const double denom = 4.0 - c[i - 1];
+        c[i] = 1.0 / denom;
+        d[i] = (rhs - d[i - 1]) / denom;
+    }
+    for (int i = n - 2; i >= 1; --i) {
+        m[i] = d[i] - c[i] * m[i + 1];
+    }
+    return m;
+}
+
+// 在网格坐标 u 处计算样条值
+double splineAt(const QVector<double>& y, const QVector<double>& m, double u)
+{
+    const int n = y.size();
+    if (n == 0) return 0.0;
+    if (n == 1) return y[0];
+    int i = (int)std::floor(u);
+    i = std::min(std::max(i, 0), n - 2);
+    const double t = u - i;
+    const double s = 1.0 - t;
+    return s * y[i] + t * y[i + 1]
+         + ((s * s * s - s) * m[i] + (t * t * t - t) * m[i + 1]) / 6.0;
+}
+
+// 全部为正时转换为对数形式存储
+bool toLogIfPositive(QVector<double>& y)
+{
+    for (double v : y) {
+        if (!(v > 0.0) || !std::isfinite(v)) return false;
+    }
+    for (double& v : y) v = std::log(v);
+    return true;
+}
+}
+
+bool TypeCurveCache::Key::operator==(const Key& other) const
+{
+    return modelType == other.modelType && method == other.method && order == other.order
+        && nf == other.nf && M12 == other.M12 && LfD == other.LfD && rmD == other.rmD
+        && reD == other.reD && omega1 == other.omega1 && omega2 == other.omega2
+        && lambda1 == other.lambda1 && cD == other.cD && S == other.S && gamaD == other.gamaD
+        && quadratureTolerance == other.quadratureTolerance && asymptoticTolerance == other.asymptoticTolerance;
+}
+
+size_t qHash(const TypeCurveCache::Key& key, size_t seed)
+{
+    return qHashMulti(seed, key.modelType, key.method, key.order, key.nf, key.M12, key.LfD,
+                      key.rmD, key.reD, key.omega1, key.omega2, key.lambda1, key.cD, key.S, key.gamaD,
+                      key.quadratureTolerance, key.asymptoticTolerance);
+}
+
+bool TypeCurveCache::Curve::covers(double tDMin, double tDMax) const
+{
+    if (pD.size() < 2 || !(tDMin > 0.0) || !(tDMax >= tDMin)) return false;
+    const double lo = log10Start + 0.5;
+    const double hi = log10Start + step * (pD.size() - 1) - 0.5;
+    return std::log10(tDMin) >= lo && std::log10(tDMax) <= hi;
+}
+
+double TypeCurveCache::Curve::pressureAt(double tD) const
+{
+    const double u = (std::log10(tD) - log10Start) / step;
+    const double v = splineAt(pD, pD2, u);
+    return pDLog ? std::exp(v) : v;
+}
+
+double TypeCurveCache::Curve::derivativeAt(double tD) const
+{
+    const double u = (std::log10(tD) - log10Start) / step;
+    const double v = splineAt(deriv, deriv2, u);
+    return derivLog ? std::exp(v) : v;
+}
+
+TypeCurveCache::TypeCurveCache(int maxPoints)
+    : m_cache(maxPoints)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+QVector<double> TypeCurveCache::makeGrid(double tDMin, double tDMax)
+{
+    const int first = (int)std::floor(std::log10(tDMin)) - kMarginDecades;
+    const int last = (int)std::ceil(std::log10(tDMax)) + kMarginDecades;
+    const int count = (last - first) * kPointsPerDecade + 1;
+
+    QVector<double> grid(count);
+    for (int i = 0; i < count; ++i) {
+        grid[i] = std::pow(10.0, first + double(i) / kPointsPerDecade);
+    }
+    return grid;
+}
+
+TypeCurveCache::Curve TypeCurveCache::buildCurve(const QVector<double>& grid, const QVector<double>& pD, const QVector<double>& deriv)
+{
+    Curve curve;
+    curve.log10Start = grid.isEmpty() ? 0.0 : std::round(std::log10(grid.first()) * kPointsPerDecade) / kPointsPerDecade;
+    curve.step = 1.0 / kPointsPerDecade;
+    curve.pD = pD;
+    curve.deriv = deriv;
+    curve.pDLog = toLogIfPositive(curve.pD);
+    curve.derivLog = toLogIfPositive(curve.deriv);
+    curve.pD2 = splineSecondDerivatives(curve.pD);
+    curve.deriv2 = splineSecondDerivatives(curve.deriv);
+    return curve;
+}
+
+bool TypeCurveCache::find(const Key& key, double tDMin, double tDMax, Curve& out)
+{
+    QMutexLocker locker(&m_mutex);
+    const Curve* curve = m_cache.object(key);
+    if (curve && curve->covers(tDMin, tDMax)) {
+        out = *curve;
+        ++m_hits;
+        return true;
+    }
+    ++m_misses;
+    return false;
+}
+
+void TypeCurveCache::insert(const Key& key, const Curve& curve)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.insert(key, new Curve(curve), std::max<qsizetype>(1, curve.pD.size()));
+}
+
+void TypeCurveCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.clear();
+}
+
+void TypeCurveCache::setMaxPoints(int maxPoints)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.setMaxCost(maxPoints);
+}
+
+int TypeCurveCache::count() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cache.count();
+}
+
+qint64 TypeCurveCache::hitCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hits;
+}
+
+qint64 TypeCurveCache::missCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_misses;
+}
+
+void TypeCurveCache::resetStatistics()
+{
+    QMutexLocker locker(&m_mutex);
+    m_hits = 0;
+    m_misses = 0;
+}
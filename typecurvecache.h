@@ -0,0 +1,95 @@
+/*
+ * typecurvecache.h
+ * 文件作用: 无因次典型曲线缓存头文件
+ * 功能描述:
+ * 1. phi、mu、B、Ct、q、h 等参数只改变时间换算系数 (tdCoeff) 与压力换算系数 (pCoeff)，
+ *    不改变无因次解 pD(tD)。缓存以无因次参数组 (M12、LfD、rmD、reD、omega、lambda、nf、cD、S、gamaD)
+ *    加模型类型、反演方法与积分、渐近误差限为键，保存稠密对数 tD 网格上的 pD 与导数曲线。
+ * 2. 仅改变换算参数时，直接由缓存曲线平移 (tD = tdCoeff·t) 并在对数空间插值得到结果，无需重新反演。
+ * 3. 网格按十进制对齐 (每十倍程固定点数) 并在两端各留一个十倍程余量，插值采用自然三次样条；
+ *    曲线全部为正时在 (ln tD, ln y) 空间插值，否则在 (ln tD, y) 空间插值。
+ * 4. 基于 QCache 的 LRU 淘汰，按网格点数计算占用，内存上限可设置；提供命中/未命中计数。
+ * 5. 内部加锁，可在拟合线程与界面线程中同时使用。
+ */
+
+#ifndef TYPECURVECACHE_H
+#define TYPECURVECACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QVector>
+#include <QHashFunctions>
+
+class TypeCurveCache
+{
+public:
+    // 每十倍程的网格点数
+    static const int kPointsPerDecade = 20;
+
+    // 缓存键: 决定无因次解的全部参数
+    struct Key {
+        int modelType = 0;
+        int method = 0;         // 反演方法
+        int order = 0;          // 反演阶数
+        int nf = 0;
+        double M12 = 0.0;
+        double LfD = 0.0;
+        double rmD = 0.0;
+        double reD = 0.0;
+        double omega1 = 0.0;
+        double omega2 = 0.0;
+        double lambda1 = 0.0;
+        double cD = 0.0;
+        double S = 0.0;
+        double gamaD = 0.0;
+        double quadratureTolerance = 0.0;   // 裂缝积分误差限
+        double asymptoticTolerance = 0.0;   // 渐近快速路径误差限 (不同误差限的曲线不混用)
+
+        bool operator==(const Key& other) const;
+    };
+
+    // 稠密对数网格上的无因次曲线 (网格点 log10(tD) = log10Start + i·step)
+    struct Curve {
+        double log10Start = 0.0;
+        double step = 1.0 / kPointsPerDecade;
+        QVector<double> pD, pD2;            // 压力 (或其对数) 及样条二阶导数
+        QVector<double> deriv, deriv2;      // 导数 (或其对数) 及样条二阶导数
+        bool pDLog = false;                 // pD 是否以对数形式存储
+        bool derivLog = false;              // 导数是否以对数形式存储
+
+        // 是否覆盖 [tDMin, tDMax] (两端保留半个十倍程的样条内部区间)
+        bool covers(double tDMin, double tDMax) const;
+        double pressureAt(double tD) const;
+        double derivativeAt(double tD) const;
+    };
+
+    explicit TypeCurveCache(int maxPoints = 400000);
+
+    // 生成覆盖 [tDMin, tDMax] 的对齐网格 (两端各外扩一个十倍程)
+    static QVector<double> makeGrid(double tDMin, double tDMax);
+    // 由网格上的 pD 与导数建立样条曲线
+    static Curve buildCurve(const QVector<double>& grid, const QVector<double>& pD, const QVector<double>& deriv);
+
+    // 查找覆盖 [tDMin, tDMax] 的曲线，找到时复制到 out 并返回 true
+    bool find(const Key& key, double tDMin, double tDMax, Curve& out);
+    void insert(const Key& key, const Curve& curve);
+
+    void clear();
+    void setMaxPoints(int maxPoints);
+    int count() const;
+
+    // 命中统计
+    qint64 hitCount() const;
+    qint64 missCount() const;
+    void resetStatistics();
+
+private:
+    mutable QMutex m_mutex;
+    QCache<Key, Curve> m_cache;
+    qint64 m_hits;
+    qint64 m_misses;
+};
+
+size_t qHash(const TypeCurveCache::Key& key, size_t seed = 0);
+
+#endif // TYPECURVECACHE_H
@@ -0,0 +1,15 @@
+# ----------------------------------------------------
+# welltest_core 计算核心静态库的链接配置
+# 用法: 在需要求解器/拟合器的工程中 include(<源码根目录>/welltest_core.pri)
+# 说明: 库由 core/welltest_core.pro 构建并输出到构建根目录的 lib 子目录，
+#       通过 WellTestProject.pro 统一构建时会先于依赖它的工程完成
+# ----------------------------------------------------
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+WELLTEST_CORE_LIBDIR = $$shadowed($$PWD)/lib
+LIBS += -L$$WELLTEST_CORE_LIBDIR -lwelltest_core
+
+win32-msvc*: PRE_TARGETDEPS += $$WELLTEST_CORE_LIBDIR/welltest_core.lib
+else: PRE_TARGETDEPS += $$WELLTEST_CORE_LIBDIR/libwelltest_core.a
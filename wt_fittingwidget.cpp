@@ -3,9 +3,11 @@
  * 文件作用: 试井拟合分析主界面类的实现文件
  * 功能描述:
  * 1. 初始化界面，集成 ChartWidget 作为绘图容器。
- * 2. 实现了多线程 Levenberg-Marquardt 拟合算法。
- * 3. 实现了数据的加载及展示。
+ * 2. 在工作线程中调用 LevenbergMarquardtFitter (或多起点的 MultiStartFitter、种群全局优化的 EvolutionaryFitter)
+ *    执行拟合，迭代结果通过信号刷新界面。
+ * 3. 实现了数据的加载及展示；拟合前可按每对数周期固定点数重采样，图中仍显示原始数据。
  * 4. [修复] 解决了滚轮调节参数时曲线颜色变蓝的问题（通过优化 Replot 时机）。
+ * 5. 观测数据带产量列时构造变产量史，理论曲线、残差与三种拟合器均按叠加原理计算。
  */
 
 #include "wt_fittingwidget.h"
@@ -15,6 +17,9 @@
 #include "fittingdatadialog.h"
 #include "pressurederivativecalculator.h"
 #include "pressurederivativecalculator1.h"
+#include "levenbergmarquardtfitter.h"
+#include "multistartfitter.h"
+#include "evolutionaryfitter.h"
 
 #include <QtConcurrent>
 #include <QMessageBox>
@@ -34,7 +39,6 @@
 #include <QJsonArray>
 #include <QDateTime>
 #include <QBuffer>
-#include <Eigen/Dense>
 
 // 构造函数
 FittingWidget::FittingWidget(QWidget *parent) :
@@ -76,6 +80,8 @@ FittingWidget::FittingWidget(QWidget *parent) :
 
     connect(this, &FittingWidget::sigIterationUpdated, this, &FittingWidget::onIterationUpdate, Qt::QueuedConnection);
     connect(this, &FittingWidget::sigProgress, ui->progressBar, &QProgressBar::setValue);
+    connect(this, &FittingWidget::sigEvaluationCount, this, &FittingWidget::onEvaluationCount, Qt::QueuedConnection);
+    connect(this, &FittingWidget::sigMultiStartSummary, this, &FittingWidget::onMultiStartSummary, Qt::QueuedConnection);
     connect(&m_watcher, &QFutureWatcher<void>::finished, this, &FittingWidget::onFitFinished);
 
     connect(ui->sliderWeight, &QSlider::valueChanged, this, &FittingWidget::onSliderWeightChanged);
@@ -83,6 +89,28 @@ FittingWidget::FittingWidget(QWidget *parent) :
     ui->sliderWeight->setRange(0, 100);
     ui->sliderWeight->setValue(50);
     onSliderWeightChanged(50);
+
+    // 重采样设置变化时重新生成拟合数据并刷新误差 (拟合进行中不改动，下次拟合开始时生效)
+    auto onResampleChanged = [this]() {
+        if(m_isFitting) return;
+        applyFitDataReduction();
+        if(m_modelManager && !m_obsTime.isEmpty()) updateModelCurve();
+    };
+    connect(ui->chkResample, &QCheckBox::toggled, this, onResampleChanged);
+    connect(ui->spinPointsPerCycle, QOverload<int>::of(&QSpinBox::valueChanged), this, onResampleChanged);
+    connect(ui->cmbResampleMethod, QOverload<int>::of(&QComboBox::currentIndexChanged), this, onResampleChanged);
+    ui->spinPointsPerCycle->setEnabled(ui->chkResample->isChecked());
+    ui->cmbResampleMethod->setEnabled(ui->chkResample->isChecked());
+    connect(ui->chkResample, &QCheckBox::toggled, ui->spinPointsPerCycle, &QWidget::setEnabled);
+    connect(ui->chkResample, &QCheckBox::toggled, ui->cmbResampleMethod, &QWidget::setEnabled);
+
+    // 多起点只用于 LM，精修只用于种群全局优化
+    auto updateEngineOptions = [this](int engine) {
+        ui->spinStarts->setEnabled(engine == Engine_LevenbergMarquardt);
+        ui->chkPolish->setEnabled(engine != Engine_LevenbergMarquardt);
+    };
+    connect(ui->cmbEngine, QOverload<int>::of(&QComboBox::currentIndexChanged), this, updateEngineOptions);
+    updateEngineOptions(ui->cmbEngine->currentIndex());
 }
 
 FittingWidget::~FittingWidget()
@@ -183,7 +211,7 @@ void FittingWidget::on_btnLoadData_clicked() {
         return;
     }
 
-    QVector<double> rawTime, rawPressureData, finalDeriv;
+    QVector<double> rawTime, rawPressureData, finalDeriv, rawRate;
     int skip = settings.skipRows;
     int rows = sourceModel->rowCount();
 
@@ -204,6 +232,10 @@ void FittingWidget::on_btnLoadData_clicked() {
                     if (itemD) finalDeriv.append(itemD->text().toDouble());
                     else finalDeriv.append(0.0);
                 }
+                if (settings.rateColIndex >= 0) {
+                    QStandardItem* itemQ = sourceModel->item(i, settings.rateColIndex);
+                    rawRate.append(itemQ ? itemQ->text().toDouble() : 0.0);
+                }
             }
         }
     }
@@ -240,14 +272,17 @@ void FittingWidget::on_btnLoadData_clicked() {
         }
     }
 
-    setObservedData(rawTime, finalDeltaP, finalDeriv);
+    setObservedData(rawTime, finalDeltaP, finalDeriv, RateSuperposition::fromRateSamples(rawTime, rawRate));
     QMessageBox::information(this, "成功", "观测数据已成功加载。");
 }
 
-void FittingWidget::setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& d) {
-    m_obsTime = t;
-    m_obsDeltaP = deltaP;
-    m_obsDerivative = d;
+void FittingWidget::setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& d,
+                                    const RateSuperposition& rates) {
+    m_rateSchedule = rates;
+    m_rawTime = t;
+    m_rawDeltaP = deltaP;
+    m_rawDerivative = d;
+    applyFitDataReduction();
 
     QVector<double> vt, vp, vd;
     for(int i=0; i<t.size(); ++i) {
@@ -268,6 +303,23 @@ void FittingWidget::setObservedData(const QVector<double>& t, const QVector<doub
     m_plot->replot();
 }
 
+// 拟合数据精简: 每个 LM 迭代的模型计算量与观测点数成正比，对数分箱后与数据跨越的周期数成正比，
+// 同时避免晚期高频采样的大量数据点主导残差权重
+void FittingWidget::applyFitDataReduction() {
+    if(ui->chkResample->isChecked()) {
+        PressureDerivativeCalculator1::resampleLogUniform(m_rawTime, m_rawDeltaP, m_rawDerivative,
+                                                          ui->spinPointsPerCycle->value(),
+                                                          ui->cmbResampleMethod->currentIndex() == 0,
+                                                          m_obsTime, m_obsDeltaP, m_obsDerivative);
+        ui->label_FitPoints->setText(QString("拟合点数: %1 (原始 %2)").arg(m_obsTime.size()).arg(m_rawTime.size()));
+    } else {
+        m_obsTime = m_rawTime;
+        m_obsDeltaP = m_rawDeltaP;
+        m_obsDerivative = m_rawDerivative;
+        ui->label_FitPoints->setText(QString("拟合点数: %1").arg(m_obsTime.size()));
+    }
+}
+
 void FittingWidget::onSliderWeightChanged(int value)
 {
     double wPressure = value / 100.0;
@@ -299,16 +351,23 @@ void FittingWidget::on_btnRunFit_clicked() {
     }
 
     m_paramChart->updateParamsFromTable();
+    applyFitDataReduction();
     m_isFitting = true;
     m_stopRequested = false;
+    m_multiStartSummary.clear();
     ui->btnRunFit->setEnabled(false);
 
     ModelManager::ModelType modelType = m_currentModelType;
     QList<FitParameter> paramsCopy = m_paramChart->getParameters();
-    double w = ui->sliderWeight->value() / 100.0;
-
-    m_watcher.setFuture(QtConcurrent::run([this, modelType, paramsCopy, w](){
-        runOptimizationTask(modelType, paramsCopy, w);
+    FitTaskSettings settings;
+    settings.weight = ui->sliderWeight->value() / 100.0;
+    settings.engine = FitEngine(ui->cmbEngine->currentIndex());
+    settings.broydenUpdates = ui->chkBroyden->isChecked();
+    settings.starts = ui->spinStarts->value();
+    settings.polish = ui->chkPolish->isChecked();
+
+    m_watcher.setFuture(QtConcurrent::run([this, modelType, paramsCopy, settings](){
+        runOptimizationTask(modelType, paramsCopy, settings);
     }));
 }
 
@@ -464,227 +523,123 @@ void FittingWidget::onExportCurveData() {
     }
 }
 
-void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight) {
-    runLevenbergMarquardtOptimization(modelType, fitParams, weight);
+void FittingWidget::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, const FitTaskSettings& settings) {
+    if(settings.engine != Engine_LevenbergMarquardt) runEvolutionaryOptimization(modelType, fitParams, settings);
+    else if(settings.starts > 1) runMultiStartOptimization(modelType, fitParams, settings);
+    else runLevenbergMarquardtOptimization(modelType, fitParams, settings);
 }
 
-// Levenberg-Marquardt
-void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight) {
-    if(m_modelManager) m_modelManager->setHighPrecision(false);
-
-    QVector<int> fitIndices;
-    for(int i=0; i<params.size(); ++i) {
-        if(params[i].isFit && params[i].name != "LfD") fitIndices.append(i);
-    }
-    int nParams = fitIndices.size();
-
-    if(nParams == 0) {
+// Levenberg-Marquardt: 迭代算法由 welltest_core 中的 LevenbergMarquardtFitter 实现，界面只负责回调转发
+void FittingWidget::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, const FitTaskSettings& settings) {
+    ModelSolver01_06* solver = m_modelManager ? m_modelManager->solver(modelType) : nullptr;
+    if(!solver) {
         QMetaObject::invokeMethod(this, "onFitFinished");
         return;
     }
 
-    double lambda = 0.01;
-    int maxIter = 50;
-    double currentSSE = 1e15;
-
-    QMap<QString, double> currentParamMap;
-    for(const auto& p : params) currentParamMap.insert(p.name, p.value);
-
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-
-    QVector<double> residuals = calculateResiduals(currentParamMap, modelType, weight);
-    currentSSE = calculateSumSquaredError(residuals);
-
-    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
-
-    for(int iter = 0; iter < maxIter; ++iter) {
-        if(m_stopRequested) break;
-        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) break;
-
-        emit sigProgress(iter * 100 / maxIter);
-
-        QVector<QVector<double>> J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight);
-        int nRes = residuals.size();
-
-        QVector<QVector<double>> H(nParams, QVector<double>(nParams, 0.0));
-        QVector<double> g(nParams, 0.0);
-
-        for(int k=0; k<nRes; ++k) {
-            for(int i=0; i<nParams; ++i) {
-                g[i] += J[k][i] * residuals[k];
-                for(int j=0; j<=i; ++j) {
-                    H[i][j] += J[k][i] * J[k][j];
-                }
-            }
-        }
-        for(int i=0; i<nParams; ++i) {
-            for(int j=i+1; j<nParams; ++j) {
-                H[i][j] = H[j][i];
-            }
-        }
-
-        bool stepAccepted = false;
-        for(int tryIter=0; tryIter<5; ++tryIter) {
-            QVector<QVector<double>> H_lm = H;
-            for(int i=0; i<nParams; ++i) {
-                H_lm[i][i] += lambda * (1.0 + std::abs(H[i][i]));
-            }
-
-            QVector<double> negG(nParams);
-            for(int i=0;i<nParams;++i) negG[i] = -g[i];
-
-            QVector<double> delta = solveLinearSystem(H_lm, negG);
-            QMap<QString, double> trialMap = currentParamMap;
-
-            for(int i=0; i<nParams; ++i) {
-                int pIdx = fitIndices[i];
-                QString pName = params[pIdx].name;
-                double oldVal = currentParamMap[pName];
-                bool isLog = (oldVal > 1e-12 && pName != "S" && pName != "nf");
-                double newVal;
-
-                if(isLog) newVal = pow(10.0, log10(oldVal) + delta[i]);
-                else newVal = oldVal + delta[i];
-
-                newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
-                trialMap[pName] = newVal;
-            }
-
-            if(trialMap.contains("L") && trialMap.contains("Lf") && trialMap["L"] > 1e-9)
-                trialMap["LfD"] = trialMap["Lf"] / trialMap["L"];
-
-            QVector<double> newRes = calculateResiduals(trialMap, modelType, weight);
-            double newSSE = calculateSumSquaredError(newRes);
-
-            if(newSSE < currentSSE) {
-                currentSSE = newSSE;
-                currentParamMap = trialMap;
-                residuals = newRes;
-                lambda /= 10.0;
-                stepAccepted = true;
-                ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-                emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
-                break;
-            } else {
-                lambda *= 10.0;
-            }
-        }
-        if(!stepAccepted && lambda > 1e10) break;
-    }
-
-    if(m_modelManager) m_modelManager->setHighPrecision(true);
-
-    if(currentParamMap.contains("L") && currentParamMap.contains("Lf") && currentParamMap["L"] > 1e-9)
-        currentParamMap["LfD"] = currentParamMap["Lf"] / currentParamMap["L"];
-
-    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, currentParamMap);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+    LevenbergMarquardtFitter fitter(solver);
+    fitter.setObservedData(m_obsTime, m_obsDeltaP, m_obsDerivative);
+    fitter.setWeight(settings.weight);
+    fitter.setRateSchedule(m_rateSchedule);
+    LevenbergMarquardtFitter::Options options;
+    options.broydenUpdates = settings.broydenUpdates;
+    fitter.setOptions(options);
+    fitter.setStopPredicate([this]() { return m_stopRequested; });
+    fitter.setProgressCallback([this](int percent, const LevenbergMarquardtFitter::EvaluationStats& stats) {
+        emit sigProgress(percent);
+        emit sigEvaluationCount(stats.modelEvaluations(), stats.residualEvaluations, stats.jacobianEvaluations, stats.broydenUpdates);
+    });
+    fitter.setIterationCallback([this](double mse, const QMap<QString, double>& p, const ModelCurveData& curve) {
+        emit sigIterationUpdated(mse, p, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    });
+
+    // 拟合开始时取一份求解器配置按次传入，不修改共享求解器，界面与其他拟合页的计算不受影响
+    fitter.fit(params, m_modelManager->solverConfig(modelType));
 
     QMetaObject::invokeMethod(this, "onFitFinished");
 }
 
-QVector<double> FittingWidget::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight) {
-    if(!m_modelManager || m_obsTime.isEmpty()) return QVector<double>();
-
-    ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, params, m_obsTime);
-    const QVector<double>& pCal = std::get<1>(res);
-    const QVector<double>& dpCal = std::get<2>(res);
-
-    QVector<double> r;
-    double wp = weight;
-    double wd = 1.0 - weight;
-
-    int count = qMin(m_obsDeltaP.size(), pCal.size());
-    for(int i=0; i<count; ++i) {
-        if(m_obsDeltaP[i] > 1e-10 && pCal[i] > 1e-10)
-            r.append( (log(m_obsDeltaP[i]) - log(pCal[i])) * wp );
-        else
-            r.append(0.0);
+// 多起点: 各起点并行拟合，结束后把最优极小值显示到参数表与曲线，并列出全部互不相同的极小值
+void FittingWidget::runMultiStartOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, const FitTaskSettings& settings) {
+    ModelSolver01_06* solver = m_modelManager ? m_modelManager->solver(modelType) : nullptr;
+    if(!solver) {
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
     }
 
-    int dCount = qMin(m_obsDerivative.size(), dpCal.size());
-    dCount = qMin(dCount, count);
-    for(int i=0; i<dCount; ++i) {
-        if(m_obsDerivative[i] > 1e-10 && dpCal[i] > 1e-10)
-            r.append( (log(m_obsDerivative[i]) - log(dpCal[i])) * wd );
-        else
-            r.append(0.0);
+    MultiStartFitter fitter(solver);
+    fitter.setObservedData(m_obsTime, m_obsDeltaP, m_obsDerivative);
+    fitter.setWeight(settings.weight);
+    fitter.setRateSchedule(m_rateSchedule);
+    MultiStartFitter::Options options;
+    options.starts = settings.starts;
+    options.lmOptions.broydenUpdates = settings.broydenUpdates;
+    fitter.setOptions(options);
+    fitter.setStopPredicate([this]() { return m_stopRequested; });
+    fitter.setProgressCallback([this](int percent, const LevenbergMarquardtFitter::EvaluationStats& stats) {
+        emit sigProgress(percent);
+        emit sigEvaluationCount(stats.modelEvaluations(), stats.residualEvaluations, stats.jacobianEvaluations, stats.broydenUpdates);
+    });
+
+    const SolverConfig config = m_modelManager->solverConfig(modelType);
+    MultiStartFitter::Result result = fitter.fit(params, config);
+
+    if(!result.minima.isEmpty()) {
+        const MultiStartFitter::Minimum& best = result.minima.first();
+        LevenbergMarquardtFitter curveFitter(solver);
+        curveFitter.setRateSchedule(m_rateSchedule);
+        ModelCurveData curve = curveFitter.calculateCurve(best.params, QVector<double>(), config.withHighPrecision(true));
+        emit sigIterationUpdated(best.mse, best.params, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
     }
-    return r;
-}
-
-QVector<QVector<double>> FittingWidget::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight) {
-    int nRes = baseResiduals.size();
-    int nParams = fitIndices.size();
-    QVector<QVector<double>> J(nRes, QVector<double>(nParams));
 
-    for(int j = 0; j < nParams; ++j) {
-        int idx = fitIndices[j];
-        QString pName = currentFitParams[idx].name;
-        double val = params.value(pName);
-        bool isLog = (val > 1e-12 && pName != "S" && pName != "nf");
-
-        double h;
-        QMap<QString, double> pPlus = params;
-        QMap<QString, double> pMinus = params;
-
-        if(isLog) {
-            h = 0.01;
-            double valLog = log10(val);
-            pPlus[pName] = pow(10.0, valLog + h);
-            pMinus[pName] = pow(10.0, valLog - h);
-        } else {
-            h = 1e-4;
-            pPlus[pName] = val + h;
-            pMinus[pName] = val - h;
-        }
-
-        auto updateDeps = [](QMap<QString,double>& map) {
-            if(map.contains("L") && map.contains("Lf") && map["L"] > 1e-9)
-                map["LfD"] = map["Lf"] / map["L"];
-        };
-
-        if(pName == "L" || pName == "Lf") { updateDeps(pPlus); updateDeps(pMinus); }
-
-        QVector<double> rPlus = calculateResiduals(pPlus, modelType, weight);
-        QVector<double> rMinus = calculateResiduals(pMinus, modelType, weight);
-
-        if(rPlus.size() == nRes && rMinus.size() == nRes) {
-            for(int i=0; i<nRes; ++i) {
-                J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * h);
-            }
+    // 极小值列表: 误差、收敛到该处的起点数及各拟合参数值
+    QString summary = QString("共 %1 个起点: %2 个收敛，%3 个因落后被提前终止。\n互不相同的极小值 (按误差排序):\n")
+                          .arg(settings.starts).arg(result.completedStarts).arg(result.prunedStarts);
+    const int shown = qMin(result.minima.size(), 10);
+    for(int i = 0; i < shown; ++i) {
+        const MultiStartFitter::Minimum& m = result.minima[i];
+        QStringList values;
+        for(const FitParameter& p : params) {
+            if(p.isFit && p.name != "LfD") values << QString("%1=%2").arg(p.name).arg(m.params.value(p.name), 0, 'g', 5);
         }
+        summary += QString("%1. MSE=%2 (%3 个起点)  %4\n").arg(i + 1).arg(m.mse, 0, 'e', 3).arg(m.hits).arg(values.join(", "));
     }
-    return J;
-}
+    if(result.minima.size() > shown) summary += QString("... 另有 %1 个极小值未列出\n").arg(result.minima.size() - shown);
+    if(!result.minima.isEmpty()) summary += "参数表已更新为第 1 个极小值。";
+    emit sigMultiStartSummary(summary);
 
-QVector<double> FittingWidget::solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b) {
-    int n = b.size();
-    if (n == 0) return QVector<double>();
-
-    Eigen::MatrixXd matA(n, n);
-    Eigen::VectorXd vecB(n);
+    QMetaObject::invokeMethod(this, "onFitFinished");
+}
 
-    for (int i = 0; i < n; ++i) {
-        vecB(i) = b[i];
-        for (int j = 0; j < n; ++j) {
-            matA(i, j) = A[i][j];
-        }
+// 差分进化 / CMA-ES: 每代最优个体改进时经 sigIterationUpdated 刷新界面，可选以 LM 精修
+void FittingWidget::runEvolutionaryOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, const FitTaskSettings& settings) {
+    ModelSolver01_06* solver = m_modelManager ? m_modelManager->solver(modelType) : nullptr;
+    if(!solver) {
+        QMetaObject::invokeMethod(this, "onFitFinished");
+        return;
     }
 
-    Eigen::VectorXd x = matA.ldlt().solve(vecB);
-
-    QVector<double> res(n);
-    for (int i = 0; i < n; ++i) res[i] = x(i);
-    return res;
-}
+    EvolutionaryFitter fitter(solver);
+    fitter.setObservedData(m_obsTime, m_obsDeltaP, m_obsDerivative);
+    fitter.setWeight(settings.weight);
+    fitter.setRateSchedule(m_rateSchedule);
+    EvolutionaryFitter::Options options;
+    options.method = settings.engine == Engine_CmaEs ? EvolutionaryFitter::CmaEs : EvolutionaryFitter::DifferentialEvolution;
+    options.polishWithLevenbergMarquardt = settings.polish;
+    options.lmOptions.broydenUpdates = settings.broydenUpdates;
+    fitter.setOptions(options);
+    fitter.setStopPredicate([this]() { return m_stopRequested; });
+    fitter.setProgressCallback([this](int percent, const LevenbergMarquardtFitter::EvaluationStats& stats) {
+        emit sigProgress(percent);
+        emit sigEvaluationCount(stats.modelEvaluations(), stats.residualEvaluations, stats.jacobianEvaluations, stats.broydenUpdates);
+    });
+    fitter.setIterationCallback([this](double mse, const QMap<QString, double>& p, const ModelCurveData& curve) {
+        emit sigIterationUpdated(mse, p, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    });
+
+    fitter.fit(params, m_modelManager->solverConfig(modelType));
 
-double FittingWidget::calculateSumSquaredError(const QVector<double>& residuals) {
-    double sse = 0.0;
-    for(double v : residuals) sse += v*v;
-    return sse;
+    QMetaObject::invokeMethod(this, "onFitFinished");
 }
 
 QVector<double> FittingWidget::parseSensitivityValues(const QString& text) {
@@ -750,16 +705,28 @@ void FittingWidget::updateModelCurve() {
     QList<QColor> colors = { Qt::red, Qt::blue, QColor(0,180,0), Qt::magenta, QColor(255,140,0), Qt::cyan, Qt::darkRed, Qt::darkBlue };
 
     if (isSensitivityMode) {
+        // 全部敏感性取值一次性批量计算
+        QVector<QMap<QString, double>> paramSets;
         for(int i = 0; i < sensitivityValues.size(); ++i) {
-            double val = sensitivityValues[i];
             QMap<QString, double> currentParams = baseParams;
-            currentParams[sensitivityKey] = val;
+            currentParams[sensitivityKey] = sensitivityValues[i];
 
             if (sensitivityKey == "L" || sensitivityKey == "Lf") {
                 if(currentParams["L"] > 1e-9) currentParams["LfD"] = currentParams["Lf"] / currentParams["L"];
             }
+            paramSets.append(currentParams);
+        }
+        QVector<ModelCurveData> results;
+        if (m_rateSchedule.isEmpty()) {
+            results = m_modelManager->calculateTheoreticalCurves(type, paramSets, targetT);
+        } else {
+            for (const auto& currentParams : paramSets)
+                results.append(m_modelManager->calculateVariableRateCurve(type, currentParams, m_rateSchedule, targetT, m_modelManager->solverConfig(type)));
+        }
 
-            ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, currentParams, targetT);
+        for(int i = 0; i < sensitivityValues.size(); ++i) {
+            double val = sensitivityValues[i];
+            const ModelCurveData& res = results[i];
 
             QColor c = colors[i % colors.size()];
             QString legendSuffix = QString("%1=%2").arg(sensitivityKey).arg(val);
@@ -777,7 +744,9 @@ void FittingWidget::updateModelCurve() {
         // [修复] 敏感性分析循环结束后统一刷新
         m_plot->replot();
     } else {
-        ModelCurveData res = m_modelManager->calculateTheoreticalCurve(type, baseParams, targetT);
+        ModelCurveData res = m_rateSchedule.isEmpty()
+            ? m_modelManager->calculateTheoreticalCurve(type, baseParams, targetT)
+            : m_modelManager->calculateVariableRateCurve(type, baseParams, m_rateSchedule, targetT, m_modelManager->solverConfig(type));
 
         plotCurves(std::get<0>(res), std::get<1>(res), std::get<2>(res), true);
 
@@ -790,8 +759,12 @@ void FittingWidget::updateModelCurve() {
         }
 
         if (!m_obsTime.isEmpty()) {
-            QVector<double> residuals = calculateResiduals(baseParams, type, ui->sliderWeight->value()/100.0);
-            double sse = calculateSumSquaredError(residuals);
+            LevenbergMarquardtFitter fitter(m_modelManager->solver(type));
+            fitter.setObservedData(m_obsTime, m_obsDeltaP, m_obsDerivative);
+            fitter.setWeight(ui->sliderWeight->value()/100.0);
+            fitter.setRateSchedule(m_rateSchedule);
+            QVector<double> residuals = fitter.calculateResiduals(baseParams, m_modelManager->solverConfig(type));
+            double sse = LevenbergMarquardtFitter::calculateSumSquaredError(residuals);
             ui->label_Error->setText(QString("误差(MSE): %1").arg(sse/residuals.size(), 0, 'e', 3));
         }
         // [修复] 单曲线模式设置颜色后统一刷新，解决颜色错乱问题
@@ -830,7 +803,18 @@ void FittingWidget::onIterationUpdate(double err, const QMap<QString,double>& p,
 void FittingWidget::onFitFinished() {
     m_isFitting = false;
     ui->btnRunFit->setEnabled(true);
-    QMessageBox::information(this, "完成", "拟合完成。");
+    if(!m_multiStartSummary.isEmpty()) QMessageBox::information(this, "多起点拟合完成", m_multiStartSummary);
+    else QMessageBox::information(this, "完成", "拟合完成。");
+}
+
+void FittingWidget::onMultiStartSummary(const QString& summary) {
+    m_multiStartSummary = summary;
+}
+
+// 显示拟合过程中消耗的模型计算次数 (完整雅可比矩阵按曲线条数折算)
+void FittingWidget::onEvaluationCount(int modelEvaluations, int residualEvaluations, int jacobianEvaluations, int broydenUpdates) {
+    ui->label_Evaluations->setText(QString("模型计算次数: %1 (残差 %2, 完整雅可比 %3, Broyden 更新 %4)")
+                                   .arg(modelEvaluations).arg(residualEvaluations).arg(jacobianEvaluations).arg(broydenUpdates));
 }
 
 void FittingWidget::plotCurves(const QVector<double>& t, const QVector<double>& p, const QVector<double>& d, bool isModel) {
@@ -897,6 +881,12 @@ QJsonObject FittingWidget::getJsonState() const
     root["modelName"] = ModelManager::getModelTypeName(m_currentModelType);
     root["fitWeightVal"] = ui->sliderWeight->value();
 
+    QJsonObject resample;
+    resample["enabled"] = ui->chkResample->isChecked();
+    resample["pointsPerCycle"] = ui->spinPointsPerCycle->value();
+    resample["method"] = ui->cmbResampleMethod->currentIndex();
+    root["fitDataResample"] = resample;
+
     QJsonObject plotRange;
     plotRange["xMin"] = m_plot->xAxis->range().lower;
     plotRange["xMax"] = m_plot->xAxis->range().upper;
@@ -919,13 +909,23 @@ QJsonObject FittingWidget::getJsonState() const
     root["parameters"] = paramsArray;
 
     QJsonArray timeArr, pressArr, derivArr;
-    for(double v : m_obsTime) timeArr.append(v);
-    for(double v : m_obsDeltaP) pressArr.append(v);
-    for(double v : m_obsDerivative) derivArr.append(v);
+    // 保存原始数据，重采样在加载时按保存的设置重新生成
+    for(double v : m_rawTime) timeArr.append(v);
+    for(double v : m_rawDeltaP) pressArr.append(v);
+    for(double v : m_rawDerivative) derivArr.append(v);
     QJsonObject obsData;
     obsData["time"] = timeArr;
     obsData["pressure"] = pressArr;
     obsData["derivative"] = derivArr;
+    if (!m_rateSchedule.isEmpty()) {
+        QJsonArray startArr, rateArr;
+        for (const RateSuperposition::Step& step : m_rateSchedule.steps()) {
+            startArr.append(step.startTime);
+            rateArr.append(step.rate);
+        }
+        obsData["rateStartTime"] = startArr;
+        obsData["rate"] = rateArr;
+    }
     root["observedData"] = obsData;
 
     return root;
@@ -977,6 +977,21 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         ui->sliderWeight->setValue(val);
     }
 
+    if (root.contains("fitDataResample")) {
+        QJsonObject resample = root["fitDataResample"].toObject();
+        ui->chkResample->blockSignals(true);
+        ui->spinPointsPerCycle->blockSignals(true);
+        ui->cmbResampleMethod->blockSignals(true);
+        ui->chkResample->setChecked(resample["enabled"].toBool());
+        ui->spinPointsPerCycle->setValue(resample["pointsPerCycle"].toInt(20));
+        ui->cmbResampleMethod->setCurrentIndex(resample["method"].toInt());
+        ui->spinPointsPerCycle->setEnabled(ui->chkResample->isChecked());
+        ui->cmbResampleMethod->setEnabled(ui->chkResample->isChecked());
+        ui->chkResample->blockSignals(false);
+        ui->spinPointsPerCycle->blockSignals(false);
+        ui->cmbResampleMethod->blockSignals(false);
+    }
+
     if (root.contains("observedData")) {
         QJsonObject obs = root["observedData"].toObject();
         QJsonArray tArr = obs["time"].toArray();
@@ -988,7 +1003,11 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         for(auto v : pArr) p.append(v.toDouble());
         for(auto v : dArr) d.append(v.toDouble());
 
-        setObservedData(t, p, d);
+        QVector<double> rateStart, rate;
+        for(auto v : obs["rateStartTime"].toArray()) rateStart.append(v.toDouble());
+        for(auto v : obs["rate"].toArray()) rate.append(v.toDouble());
+
+        setObservedData(t, p, d, RateSuperposition::fromStepData(rateStart, rate));
     }
 
     updateModelCurve();
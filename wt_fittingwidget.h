@@ -3,8 +3,9 @@
  * 文件作用: 试井拟合分析主界面类的头文件
  * 功能描述:
  * 1. 定义拟合分析界面的主要控件成员变量和布局逻辑。
- * 2. 声明用于Levenberg-Marquardt非线性回归拟合的核心算法函数。
- * 3. 声明观测数据（时间、压差、导数）的管理函数。
+ * 2. 声明 Levenberg-Marquardt、多起点与种群全局优化 (DE / CMA-ES) 拟合任务的启动函数
+ *    (算法见 levenbergmarquardtfitter.h、multistartfitter.h、evolutionaryfitter.h)。
+ * 3. 声明观测数据（时间、压差、导数）的管理函数，原始数据用于显示，拟合可使用对数重采样后的数据。
  * 4. 支持多文件数据源加载。
  * 5. 支持参数敏感性分析（多值输入绘制多条曲线）。
  */
@@ -40,8 +41,9 @@ public:
     // 设置项目数据模型集合 (支持多文件)
     void setProjectDataModels(const QMap<QString, QStandardItemModel*>& models);
 
-    // 设置观测数据
-    void setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& deriv);
+    // 设置观测数据 (rates 为变产量史，为空时按恒定产量计算)
+    void setObservedData(const QVector<double>& t, const QVector<double>& deltaP, const QVector<double>& deriv,
+                         const RateSuperposition& rates = RateSuperposition());
 
     // 更新基础参数
     void updateBasicParameters();
@@ -60,6 +62,12 @@ signals:
     // 进度信号
     void sigProgress(int progress);
 
+    // 模型计算次数信号 (总次数、残差计算次数、完整雅可比矩阵计算次数、Broyden 更新次数)
+    void sigEvaluationCount(int modelEvaluations, int residualEvaluations, int jacobianEvaluations, int broydenUpdates);
+
+    // 多起点拟合结束信号 (互不相同极小值的排序列表文本)
+    void sigMultiStartSummary(const QString& summary);
+
     // 请求保存信号
     void sigRequestSave();
 
@@ -88,6 +96,8 @@ private slots:
     // 内部拟合逻辑槽函数
     void onIterationUpdate(double err, const QMap<QString,double>& p, const QVector<double>& t, const QVector<double>& p_curve, const QVector<double>& d_curve);
     void onFitFinished();
+    void onEvaluationCount(int modelEvaluations, int residualEvaluations, int jacobianEvaluations, int broydenUpdates);
+    void onMultiStartSummary(const QString& summary);
     void onSliderWeightChanged(int value);
 
 private:
@@ -108,14 +118,23 @@ private:
     // 参数表格管理类
     FittingParameterChart* m_paramChart;
 
-    // 观测数据缓存
+    // 原始观测数据 (图中显示与项目保存使用)
+    QVector<double> m_rawTime;
+    QVector<double> m_rawDeltaP;
+    QVector<double> m_rawDerivative;
+
+    // 拟合用观测数据 (对数重采样开启时为精简后的数据，否则与原始数据相同)
     QVector<double> m_obsTime;
     QVector<double> m_obsDeltaP;
     QVector<double> m_obsDerivative;
 
+    // 变产量史 (加载数据时选择了产量列才非空)，非空时理论曲线与拟合残差均按叠加原理计算
+    RateSuperposition m_rateSchedule;
+
     // 拟合状态控制
     bool m_isFitting;
     bool m_stopRequested;
+    QString m_multiStartSummary;    // 最近一次多起点拟合的极小值列表 (拟合完成时显示)
     QFutureWatcher<void> m_watcher;
 
     // 初始化图表设置
@@ -127,21 +146,32 @@ private:
     // 更新模型曲线（包含敏感性分析逻辑及 LfD 自动计算）
     void updateModelCurve();
 
-    // 核心拟合算法函数 (Levenberg-Marquardt)
-    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight);
-    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight);
-
-    // 计算残差
-    QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight);
-
-    // 计算雅可比矩阵
-    QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& residuals, const QVector<int>& fitIndices, ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams, double weight);
-
-    // 求解线性方程组
-    QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
-
-    // 计算平方误差和
-    double calculateSumSquaredError(const QVector<double>& residuals);
+    // 按界面的重采样设置由原始观测数据生成拟合用数据
+    void applyFitDataReduction();
+
+    // 拟合算法 (与界面 cmbEngine 的选项顺序一致)
+    enum FitEngine {
+        Engine_LevenbergMarquardt = 0,
+        Engine_DifferentialEvolution,
+        Engine_CmaEs
+    };
+
+    // 拟合任务设置 (在界面线程中读取，按值传给工作线程)
+    struct FitTaskSettings {
+        double weight = 0.5;            // 压差残差权重
+        FitEngine engine = Engine_LevenbergMarquardt;
+        bool broydenUpdates = false;    // LM 使用 Broyden 秩一更新
+        int starts = 1;                 // LM 起点个数，大于 1 时为多起点拟合
+        bool polish = true;             // 全局优化结束后以 LM 精修最优个体
+    };
+
+    // 核心拟合算法函数: 按设置分派到 LM、多起点 LM 或种群全局优化
+    void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, const FitTaskSettings& settings);
+    void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, const FitTaskSettings& settings);
+    // 多起点全局拟合 (算法见 multistartfitter.h)
+    void runMultiStartOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, const FitTaskSettings& settings);
+    // 差分进化 / CMA-ES 全局拟合 (算法见 evolutionaryfitter.h)
+    void runEvolutionaryOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, const FitTaskSettings& settings);
 
     // 辅助绘图函数
     QString getPlotImageBase64();
@@ -6,6 +6,7 @@
  * 2. 响应用户操作，收集界面参数，调用 ModelSolver01_06 进行计算。
  * 3. 将计算结果绘制在 QCustomPlot 图表上。
  * 4. [逻辑] 实现了 LfD 随 L 和 Lf 变化的自动计算逻辑。
+ * 5. 可选自适应时间网格：只在曲线转折处加密时间点，不再需要手动指定数据点数。
  */
 
 #include "wt_modelwidget.h"
@@ -68,12 +69,25 @@ WT_ModelWidget::ModelCurveData WT_ModelWidget::calculateTheoreticalCurve(const Q
     return ModelCurveData();
 }
 
+QVector<WT_ModelWidget::ModelCurveData> WT_ModelWidget::calculateTheoreticalCurves(const QVector<QMap<QString, double>>& paramSets, const QVector<double>& providedTime)
+{
+    if (m_solver) {
+        return m_solver->calculateTheoreticalCurves(paramSets, providedTime);
+    }
+    return QVector<ModelCurveData>(paramSets.size());
+}
+
 void WT_ModelWidget::setHighPrecision(bool high)
 {
     m_highPrecision = high;
     if (m_solver) m_solver->setHighPrecision(high);
 }
 
+void WT_ModelWidget::setInversionMethod(LaplaceInversion::Method method)
+{
+    if (m_solver) m_solver->setInversionMethod(method);
+}
+
 void WT_ModelWidget::initUi() {
     using MT = ModelSolver01_06::ModelType;
     if (m_type == MT::Model_1 || m_type == MT::Model_2) {
@@ -147,6 +161,7 @@ void WT_ModelWidget::setupConnections() {
     connect(ui->LfEdit, &QLineEdit::editingFinished, this, &WT_ModelWidget::onDependentParamsChanged);
 
     connect(ui->checkShowPoints, &QCheckBox::toggled, this, &WT_ModelWidget::onShowPointsToggled);
+    connect(ui->checkAdaptive, &QCheckBox::toggled, this, &WT_ModelWidget::onAdaptiveToggled);
 
     // 转发模型选择按钮信号
     connect(ui->btnSelectModel, &QPushButton::clicked, this, &WT_ModelWidget::requestModelSelection);
@@ -229,6 +244,11 @@ void WT_ModelWidget::onShowPointsToggled(bool checked) {
     plot->replot();
 }
 
+// 自适应网格模式下数据点数由误差控制决定，点数输入框不可用
+void WT_ModelWidget::onAdaptiveToggled(bool checked) {
+    ui->pointsEdit->setEnabled(!checked);
+}
+
 void WT_ModelWidget::onCalculateClicked() {
     ui->calculateButton->setEnabled(false);
     ui->calculateButton->setText("计算中...");
@@ -314,22 +334,34 @@ void WT_ModelWidget::runCalculation() {
     QString resultTextHeader = QString("计算完成 (%1)\n").arg(getModelName());
     if(isSensitivity) resultTextHeader += QString("敏感性参数: %1\n").arg(sensitivityKey);
 
-    // 循环计算曲线
+    // 组装全部参数组，一次性批量计算 (所有曲线的计算任务合并并行调度)
+    QVector<QMap<QString, double>> paramSets;
     for(int i = 0; i < iterations; ++i) {
         QMap<QString, double> currentParams = baseParams;
-        double val = 0;
         if (isSensitivity) {
-            val = sensitivityValues[i];
-            currentParams[sensitivityKey] = val;
+            currentParams[sensitivityKey] = sensitivityValues[i];
 
             // [逻辑] 敏感性分析中若 L 或 Lf 变化，也需联动 LfD
             if (sensitivityKey == "L" || sensitivityKey == "Lf") {
                 if(currentParams["L"] > 1e-9) currentParams["LfD"] = currentParams["Lf"] / currentParams["L"];
             }
         }
+        paramSets.append(currentParams);
+    }
+    QVector<ModelCurveData> results;
+    if (ui->checkAdaptive->isChecked() && m_solver) {
+        // 自适应网格: 每组参数各自加密 (转折位置随参数变化)
+        for (const QMap<QString, double>& params : paramSets) {
+            results.append(m_solver->calculateAdaptiveCurve(params, t.first(), t.last()));
+        }
+    } else {
+        results = calculateTheoreticalCurves(paramSets, t);
+    }
 
-        // 调用 Solver 计算
-        ModelCurveData res = calculateTheoreticalCurve(currentParams, t);
+    // 循环绘制曲线
+    for(int i = 0; i < iterations; ++i) {
+        double val = isSensitivity ? sensitivityValues[i] : 0;
+        const ModelCurveData& res = results[i];
 
         // 缓存最后一次结果用于显示
         res_tD = std::get<0>(res);
@@ -38,9 +38,15 @@ public:
     // 设置高精度模式（转发给 Solver）
     void setHighPrecision(bool high);
 
+    // 设置拉普拉斯数值反演方法（转发给 Solver）
+    void setInversionMethod(LaplaceInversion::Method method);
+
     // 直接调用求解器计算（供外部管理器使用，非 UI 交互）
     ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
 
+    // 批量计算多组参数的理论曲线（转发给 Solver）
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<QMap<QString, double>>& paramSets, const QVector<double>& providedTime = QVector<double>());
+
     // 获取当前模型名称
     QString getModelName() const;
 
@@ -59,6 +65,7 @@ public slots:
     void onDependentParamsChanged();
 
     void onShowPointsToggled(bool checked);
+    void onAdaptiveToggled(bool checked);
     void onExportData();
 
 private: